@@ -15,6 +15,9 @@ static const char JUMANJI_RC[]        = "jumanjirc";
 static const char JUMANJI_BOOKMARKS[] = "bookmarks";
 static const char JUMANJI_HISTORY[]   = "history";
 static const char JUMANJI_COOKIES[]   = "cookies";
+static const char JUMANJI_COOKIE_STORE[] = "cookiejar";
+static const char JUMANJI_BLOCKLIST[] = "blocklist";
+static const char JUMANJI_CACHE[]     = "cache";
 static const char JUMANJI_SESSIONS[]  = "sessions";
 
 /* browser specific settings */
@@ -27,7 +30,22 @@ gboolean full_content_zoom = FALSE;
 char* default_session_name = "default"; /* activates using sessions */
 int auto_save_interval     = 0;
 int search_delay           = 400; /* in millisecond */
+int status_interval        = 100; /* in millisecond */
+int hint_interval          = 100; /* in millisecond */
 int history_limit          = 0;
+int replay_interval        = 1; /* in millisecond */
+int gc_interval            = 60; /* in seconds */
+int gc_budget              = 10; /* in millisecond per pass */
+int cache_size             = 50; /* in megabytes */
+int cookie_flush_interval  = 10; /* in seconds */
+gboolean offline           = FALSE; /* serves pages from the http cache only */
+gboolean preconnect        = TRUE; /* resolves the hosts of hovered and focused links */
+gboolean prefetch          = FALSE; /* fetches their documents into the cache */
+char* preconnect_exclude   = NULL; /* domains that are never warmed up */
+int preconnect_max         = 4;
+int preconnect_delay       = 100; /* in millisecond */
+gboolean prerender         = FALSE; /* loads the next page of paginated sites offscreen */
+int prerender_memory       = 512; /* in megabytes, no prerendering above */
 
 /* download settings */
 char* download_dir     = "~/downloads/";
@@ -64,6 +82,7 @@ char* notification_w_fgcolor = "#000000";
 gboolean show_scrollbars = FALSE;
 gboolean show_statusbar  = TRUE;
 gboolean show_tabbar     = TRUE;
+int      tabbar_size     = 10; /* number of visible tabs */
 gboolean next_to_current = TRUE;
 gboolean single_instance = TRUE;
 
@@ -165,12 +184,17 @@ Mouse mouse[] = {
 Command commands[] = {
   /* command,   abbreviation,   function,            completion,   description  */
   {"back",      0,              cmd_back,            0,            "Go back in the browser history" },
+  {"block",     0,              cmd_block,           0,            "Block requests matching a hosts file or adblock list" },
   {"bmap",      0,              cmd_bmap,            0,            "Map a buffered command" },
   {"bmark",     "b",            cmd_bookmark,        0,            "Add a bookmark" },
+  {"cache",     0,              cmd_cache,           0,            "Show the cache usage or clear the cache" },
   {"forward",   "f",            cmd_forward,         0,            "Go forward in the browser history" },
+  {"har",       0,              cmd_har,             0,            "Export the request timings of the current tab as HAR" },
+  {"hide",      0,              cmd_hide,            0,            "Load element hiding rules" },
   {"map",       "m",            cmd_map,             0,            "Map a key sequence" },
   {"open",      "o",            cmd_open,            cc_open,      "Open URI in the current tab" },
   {"print",     0,              cmd_print,           0,            "Print page" },
+  {"profile",   0,              cmd_profile,         0,            "Show, export or clear the script timings" },
   {"quit",      "q",            cmd_quit,            0,            "Quit current tab" },
   {"quitall",   0,              cmd_quitall,         0,            "Quit jumanji" },
   {"reload",    0,              cmd_reload,          0,            "Reload the current web page" },
@@ -181,6 +205,7 @@ Command commands[] = {
   {"sessionsave","ssa",         cmd_sessionsave,     cc_session,   "Save session with specified name" },
   {"sessionswitch","ssw",       cmd_sessionswitch,   cc_session,   "Close all the current tabs and load session" },
   {"set",       "s",            cmd_set,             cc_set,       "Set an option" },
+  {"source",    0,              cmd_source,          0,            "Execute the commands of a file" },
   {"stop",      "st",           cmd_stop,            0,            "Stop loading the current page" },
   {"tabopen",   "t",            cmd_tabopen,         cc_open,      "Open URI in a new tab" },
   {"winopen",   "w",            cmd_winopen,         cc_open,      "Open URI in a new window" },
@@ -229,6 +254,7 @@ Setting settings[] = {
   {"history_limit",          &(history_limit),          NULL,                           'i',  1, 0, 0, "Limit history length"},
   {"auto_shrink_images",     NULL,                      "auto-shrink-images",           'b',  0, 1, 0, "Shrink standalone images to fit"},
   {"background",             NULL,                      "print-backgrounds",            'b',  0, 1, 0, "Print background images"},
+  {"cache_size",             &(cache_size),             NULL,                           'i',  0, 0, 0, "Size of the disk cache in megabytes, at most 4095"},
   {"caret_browsing",         NULL,                      "enable-caret-browsing",        'b',  0, 1, 0, "Wheter to enable caret browsing mode"},
   {"completion_bgcolor",     &(completion_bgcolor),     NULL,                           's',  1, 0, 0, "Completion background color"},
   {"completion_fgcolor",     &(completion_fgcolor),     NULL,                           's',  1, 0, 0, "Completion foreground color"},
@@ -236,6 +262,7 @@ Setting settings[] = {
   {"completion_g_fgcolor",   &(completion_g_fgcolor),   NULL,                           's',  1, 0, 0, "Completion (group) foreground color"},
   {"completion_hl_bgcolor",  &(completion_hl_bgcolor),  NULL,                           's',  1, 0, 0, "Completion (highlight) background color"},
   {"completion_hl_fgcolor",  &(completion_hl_fgcolor),  NULL,                           's',  1, 0, 0, "Completion (highlight) foreground color"},
+  {"cookie_flush_interval",  &(cookie_flush_interval),  NULL,                           'i',  0, 0, 0, "Time changed cookies are collected before they are written in seconds"},
   {"cursive_font",           NULL,                      "cursive-font-family",          's',  0, 1, 0, "Default cursive font family to display text"},
   {"default_bgcolor",        &(default_bgcolor),        NULL,                           's',  1, 0, 0, "Default background color"},
   {"default_fgcolor",        &(default_fgcolor),        NULL,                           's',  1, 0, 0, "Default foreground color"},
@@ -251,6 +278,9 @@ Setting settings[] = {
   {"font_size",              NULL,                      "default-font-size",            'i',  0, 1, 0, "The default font size to display text"},
   {"full_content_zoom",      &(full_content_zoom),      "full-content-zoom",            'b',  0, 0, 1, "Wheter the full content is scaled when zooming"},
   {"height",                 &(default_height),         NULL,                           'i',  1, 0, 0, "Default window height"},
+  {"gc_budget",              &(gc_budget),              NULL,                           'i',  0, 0, 0, "Average time spent on garbage collection per pass in milliseconds"},
+  {"gc_interval",            &(gc_interval),            NULL,                           'i',  1, 0, 0, "Interval of the garbage collection of background tabs in seconds"},
+  {"hint_interval",          &(hint_interval),          NULL,                           'i',  0, 0, 0, "Delay of the hint update after scrolling in milliseconds"},
   {"homepage",               &(home_page),              NULL,                           's',  0, 0, 0, "Home page"},
   {"images",                 NULL,                      "auto-load-images",             'b',  0, 1, 0, "Load images automatically"},
   {"inputbar_bgcolor",       &(inputbar_bgcolor),       NULL,                           's',  1, 0, 0, "Inputbar background color"},
@@ -265,8 +295,16 @@ Setting settings[] = {
   {"notification_e_fgcolor", &(notification_e_fgcolor), NULL,                           's',  1, 0, 0, "Notification (error) foreground color"},
   {"notification_w_bgcolor", &(notification_w_bgcolor), NULL,                           's',  1, 0, 0, "Notification (warning) background color"},
   {"notification_w_fgcolor", &(notification_w_fgcolor), NULL,                           's',  1, 0, 0, "Notification (warning) foreground color"},
+  {"offline",                &(offline),                NULL,                           'b',  0, 0, 0, "Load pages from the cache only"},
   {"page_cache",             NULL,                      "enable-page-cache",            'b',  0, 1, 0, "Enable page cache"},
   {"plugins",                NULL,                      "enable-plugins",               'b',  0, 1, 0, "Enable embedded plugin objects"},
+  {"preconnect",             &(preconnect),             NULL,                           'b',  0, 0, 0, "Resolve the host of hovered and focused links in advance"},
+  {"preconnect_delay",       &(preconnect_delay),       NULL,                           'i',  0, 0, 0, "Time a link has to be hovered before it is warmed up in milliseconds"},
+  {"preconnect_exclude",     &(preconnect_exclude),     NULL,                           's',  0, 0, 0, "Domains that are never warmed up"},
+  {"preconnect_max",         &(preconnect_max),         NULL,                           'i',  0, 0, 0, "Maximum number of hosts and prefetches warmed up at once"},
+  {"prefetch",               &(prefetch),               NULL,                           'b',  0, 0, 0, "Fetch hovered and focused links into the cache"},
+  {"prerender",              &(prerender),              NULL,                           'b',  0, 0, 0, "Load the next page of paginated sites in the background"},
+  {"prerender_memory",       &(prerender_memory),       NULL,                           'i',  0, 0, 0, "Memory usage in megabytes above which no page is prerendered"},
   {"private_browsing",       &(private_browsing),       "enable-private-browsing",      'b',  0, 0, 0, "Enable private browsing"},
   {"proxy",                  &(proxy),                  NULL,                           's',  0, 0, 0, "Set proxy"},
   {"resizable_text_areas",   NULL,                      "resizable-text-areas",         'b',  0, 1, 0, "Resizable text areas"},
@@ -282,6 +320,7 @@ Setting settings[] = {
   {"statusbar_fgcolor",      &(statusbar_fgcolor),      NULL,                           's',  1, 0, 0, "Statusbar foreground color"},
   {"statusbar_ssl_bgcolor",  &(statusbar_ssl_bgcolor),  NULL,                           's',  1, 0, 0, "Statusbar (SSL) background color"},
   {"statusbar_ssl_fgcolor",  &(statusbar_ssl_fgcolor),  NULL,                           's',  1, 0, 0, "Statusbar (SSL) foreground color"},
+  {"status_interval",        &(status_interval),        NULL,                           'i',  0, 0, 0, "Minimal time between loading and link updates in milliseconds"},
   {"single_instance",        &(single_instance),        NULL,                           'b',  0, 0, 0, "Allow only one instance"},
   {"stylesheet",             NULL,                      "user-stylesheet-uri",          's',  0, 1, 0, "Custom stylesheet"},
   {"tabbar",                 &(show_tabbar),            NULL,                           'b',  0, 0, 0, "Show tabbar"},
@@ -290,6 +329,7 @@ Setting settings[] = {
   {"tabbar_focus_bgcolor",   &(tabbar_focus_bgcolor),   NULL,                           's',  1, 0, 0, "Tabbar (focus) background color"},
   {"tabbar_focus_fgcolor",   &(tabbar_focus_fgcolor),   NULL,                           's',  1, 0, 0, "Tabbar (focus) foreground color"},
   {"tabbar_separator_color", &(tabbar_separator_color), NULL,                           's',  1, 0, 0, "Tabbar separator color"},
+  {"tabbar_size",            &(tabbar_size),            NULL,                           'i',  1, 0, 0, "Number of tabs shown in the tabbar"},
   {"user_agent",             &(user_agent),             "user-agent",                   's',  1, 0, 0, "User agent"},
   {"width",                  &(default_width),          NULL,                           'i',  1, 0, 0, "Default window width"},
   {"zoom_step",              &(zoom_step),              "zoom-step",                    'f',  0, 0, 0, "Zoom step"},
@@ -306,6 +346,7 @@ FunctionName function_names[] = {
   {"goto",              NULL,                  NULL},
   {"nav_history",       sc_nav_history,        bcmd_nav_history},
   {"nav_tabs",          sc_nav_tabs,           bcmd_nav_tabs},
+  {"offline",           sc_toggle_offline,     NULL},
   {"paste",             sc_paste,              NULL},
   {"proxy",             sc_toggle_proxy,       NULL},
   {"reload",            sc_reload,             NULL},
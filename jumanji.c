@@ -9,9 +9,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/stat.h>
 #include <libgen.h>
 #include <math.h>
+#define LIBSOUP_USE_UNSTABLE_REQUEST_API
 #include <libsoup/soup.h>
+#include <libsoup/soup-cache.h>
 #include <unique/unique.h>
 
 #include <gtk/gtk.h>
@@ -23,11 +26,18 @@
 /* macros */
 #define LENGTH(x) sizeof(x)/sizeof((x)[0])
 #define ALL_MASK (GDK_CONTROL_MASK | GDK_SHIFT_MASK | GDK_MOD1_MASK)
-#define GET_CURRENT_TAB_WIDGET() GET_NTH_TAB_WIDGET(gtk_notebook_get_current_page(Jumanji.UI.view))
-#define GET_NTH_TAB_WIDGET(n) GTK_SCROLLED_WINDOW(gtk_notebook_get_nth_page(Jumanji.UI.view, n))
-#define GET_CURRENT_TAB() GET_NTH_TAB(gtk_notebook_get_current_page(Jumanji.UI.view))
-#define GET_NTH_TAB(n) GET_WEBVIEW(gtk_notebook_get_nth_page(Jumanji.UI.view, n))
-#define GET_WEBVIEW(x) WEBKIT_WEB_VIEW(gtk_bin_get_child(GTK_BIN(x)))
+#define BLOCKER_MAGIC 0x424a4d4a
+#define REQUEST_LOG_LIMIT 2000 /* requests timed per page */
+#define TIMING_DATA "jumanji-timing"
+#define REVALIDATION_DATA "jumanji-revalidation"
+#define OFFLINE_HEADER "X-Jumanji-Offline" /* never sent, offline requests fail first */
+#define PRECONNECT_LIFETIME 10 /* seconds a warmed up host is not resolved again */
+#define PREFETCH_DATA "jumanji-prefetch"
+#define GET_TAB(n) ((Tab*) g_ptr_array_index(Jumanji.Tabs.list, n))
+#define GET_CURRENT_TAB_WIDGET() GTK_SCROLLED_WINDOW(Jumanji.Tabs.current->widget)
+#define GET_NTH_TAB_WIDGET(n) GTK_SCROLLED_WINDOW(GET_TAB(n)->widget)
+#define GET_CURRENT_TAB() (Jumanji.Tabs.current->view)
+#define GET_NTH_TAB(n) (GET_TAB(n)->view)
 
 #ifdef UNUSED
 #elif defined(__GNUC__)
@@ -93,6 +103,18 @@ enum mode {
   ALL                = 0x7fffffff
 };
 
+/* parts of the status that have to be redrawn */
+enum dirty {
+  DIRTY_URI          = 1 << 0,
+  DIRTY_TITLE        = 1 << 1,
+  DIRTY_TABS         = 1 << 2,
+  DIRTY_TABBAR       = 1 << 3,
+  DIRTY_POSITION     = 1 << 4,
+  DIRTY_LINK         = 1 << 5,
+  DIRTY_LABELS       = 1 << 6,
+  DIRTY_ALL          = 0x7f
+};
+
 /* typedefs */
 struct CElement
 {
@@ -248,15 +270,117 @@ struct SScript
 {
   char* path;
   char* content;
+  JSStringRef source;
+  gboolean all_frames;
+  char** patterns; /* given in the configuration */
+  GSList* include;
+  GSList* exclude;
+  GFileMonitor* monitor;
   struct SScript *next;
 };
 
 typedef struct SScript ScriptList;
 
+typedef struct STab
+{
+  int            id;
+  int            position;
+  GtkWidget     *widget;
+  WebKitWebView *view;
+  struct STab   *prerender;         /* offscreen view of the next page */
+  struct STab   *owner;             /* the tab a prerender belongs to */
+  char          *prerender_uri;
+  int            injections;
+  int            frames;
+  GPtrArray     *scripts;           /* scripts that apply to the page */
+  int            script_generation;
+  char          *stylesheet;        /* element hiding stylesheet in use */
+  char          *user_stylesheet;   /* stylesheet the hiding rules import */
+  int            blocked;           /* requests blocked on the page */
+  GPtrArray     *requests;          /* timings of the page's requests */
+  gboolean       offline;           /* served from the http cache only */
+  gboolean       label_queued;
+} Tab;
+
+typedef struct
+{
+  GtkWidget *event_box;
+  GtkWidget *label;
+  Tab       *tab;
+  int        number;
+  int        focus;
+  char      *text;
+} TabSlot;
+
+typedef struct
+{
+  char   *script;     /* path or text of the script */
+  char   *caller;
+  int     calls;
+  int     exceptions;
+  double  total;      /* in milliseconds */
+  double  max;        /* in milliseconds */
+} ScriptProfile;
+
+typedef struct
+{
+  SoupMessage *message;   /* while the request is in flight */
+  char        *method;
+  char        *uri;
+  char        *mime_type;
+  guint        status;
+  char        *status_text;
+  int          http_version;
+  goffset      size;      /* of the response body */
+  gint64       started;   /* wall clock, in microseconds */
+  gint64       queued;    /* the others are monotonic or -1 */
+  gint64       resolving;
+  gint64       resolved;
+  gint64       connecting;
+  gint64       handshaking;
+  gint64       connected;
+  gint64       sent;
+  gint64       wrote;
+  gint64       headers;
+  gint64       body;
+  gint64       finished;
+} RequestTiming;
+
+typedef struct
+{
+  GMappedFile    *mapped;    /* cache file the tables point into */
+  gchar          *data;      /* or the memory they were compiled to */
+  gsize           length;
+  guint32         n_buckets;
+  const guint32  *buckets;   /* offsets into strings plus one, 0 if empty */
+  const char     *strings;
+  guint32         n_states;
+  const guint32  *first_edge;
+  const guint32  *edge_target;
+  const guint32  *fail;
+  const guint8   *edge_char;
+  const guint8   *out;
+} BlockFilter;
+
+typedef struct
+{
+  guint32 child;
+  guint32 sibling;
+  guint8  c;
+  guint8  out;
+} TrieNode;
+
+typedef struct
+{
+  int   number; /* label of the hint if the text filter matches */
+  int   shown;  /* label currently shown, 0 if hidden */
+  char *text;   /* lowercase element text, points into Hints.texts */
+} Hint;
+
 typedef struct
 {
   int id;
-  int tab_id;
+  int tab_id; /* id of the tab, not its position */
   gdouble hadjustment;
   gdouble vadjustment;
   float zoom_level;
@@ -284,39 +408,12 @@ struct
     char            *winid;
   } UI;
 
-  struct
-  {
-    GdkColor default_fg;
-    GdkColor default_bg;
-    GdkColor inputbar_fg;
-    GdkColor inputbar_bg;
-    GdkColor statusbar_fg;
-    GdkColor statusbar_bg;
-    GdkColor statusbar_ssl_fg;
-    GdkColor statusbar_ssl_bg;
-    GdkColor tabbar_fg;
-    GdkColor tabbar_bg;
-    GdkColor tabbar_focus_fg;
-    GdkColor tabbar_focus_bg;
-    GdkColor tabbar_separator;
-    GdkColor completion_fg;
-    GdkColor completion_bg;
-    GdkColor completion_g_bg;
-    GdkColor completion_g_fg;
-    GdkColor completion_hl_fg;
-    GdkColor completion_hl_bg;
-    GdkColor notification_e_fg;
-    GdkColor notification_e_bg;
-    GdkColor notification_w_fg;
-    GdkColor notification_w_bg;
-    PangoFontDescription *font;
-  } Style;
-
   struct
   {
     GString *buffer;
     GList   *command_history;
     int      mode;
+    int      count;
     char   **arguments;
     GList   *markers;
     GList   *bookmarks;
@@ -325,6 +422,9 @@ struct
     GList   *last_closed;
     SearchEngineList  *search_engines;
     ScriptList        *scripts;
+    int                script_generation;
+    GHashTable        *profiles;
+    JSClassRef         bridge;
     WebKitWebSettings *browser_settings;
     GdkKeymap         *keymap;
     gboolean init_ui;
@@ -333,14 +433,120 @@ struct
   struct
   {
     SoupSession* session;
+    SoupCache*   cache;
+    int          requests;    /* http requests of all pages */
+    int          network;     /* requests that were sent */
+    int          revalidated; /* sent requests answered from the cache */
   } Soup;
 
+  struct
+  {
+    GPtrArray  *list;
+    GHashTable *ids;
+    Tab        *current;
+    int         next_id;
+    TabSlot    *slots;
+    int         n_slots;    /* allocated, tabbar_size may change later */
+    int         first;
+    GtkWidget  *left;
+    GtkWidget  *right;
+  } Tabs;
+
+  struct
+  {
+    Tab         *tab;
+    JSObjectRef  engine;
+    JSObjectRef  label;
+    JSObjectRef  focus;
+    JSObjectRef  follow;
+    JSObjectRef  clear;
+    Hint        *list;
+    int          length;
+    char        *texts;
+    char        *filter;
+    int          matches;
+    int          first;
+    int          active;
+    guint        rescan_id;
+  } Hints;
+
+  struct
+  {
+    GHashTable *rules;  /* domain -> selectors, "" for all domains */
+    GHashTable *sheets; /* user stylesheet and matched domains -> compiled stylesheet uri */
+  } Hiding;
+
+  struct
+  {
+    GPtrArray   *lists;
+    BlockFilter *filter;
+    gboolean     building;
+    gboolean     pending;
+    guint        build_id;
+    int          blocked;
+  } Blocker;
+
+  struct
+  {
+    guint   idle_id;
+    int     passes;
+    int     collections;
+    int     skip;       /* passes left out to stay within the budget */
+    gint64  rss_change; /* resident memory after minus before the collections, in bytes */
+  } Collector;
+
+  struct
+  {
+    GHashTable *hosts;      /* host -> time it was last warmed up */
+    char       *hovered;    /* link waiting for the hover delay */
+    char       *prefetched;
+    guint       hover_id;
+    int         pending;    /* prefetches in flight */
+  } Speculation;
+
+  struct
+  {
+    SoupCookieJar *jar;
+    GHashTable    *domains;  /* base domain -> whether its stored cookies are loaded */
+    GHashTable    *dirty;    /* base domains changed since the last flush */
+    gboolean       loading;
+    guint          flush_id;
+    GThread       *thread;   /* writing a batch */
+  } Cookies;
+
+  struct
+  {
+    int       depth;
+    gboolean  reload;
+    int       notify_level;
+    char     *notify_message;
+  } Batch;
+
+  struct
+  {
+    FILE       *record;
+    GTimer     *timer;
+    gchar     **events;
+    int         current;
+    int         pending;
+    double      started;
+    double      total;
+    SoupServer *standin;
+    char       *root;
+  } Replay;
+
   struct
   {
     GtkLabel *text;
     GtkLabel *buffer;
     GtkLabel *tabs;
     GtkLabel *position;
+    int       dirty;
+    GList    *dirty_tabs;
+    guint     flush_id;
+    int       throttled;
+    guint     throttle_id;
+    char     *link;
   } Statusbar;
 
   struct
@@ -352,36 +558,104 @@ struct
 } Jumanji;
 
 /* function declarations */
+void add_hiding_rule(const char*, const char*);
 void add_marker(int);
 gboolean auto_save(gpointer);
+void batch_begin();
+void batch_end();
+BlockFilter* blocker_compile(gchar**, const char*);
+void blocker_free(BlockFilter*);
+guint32 blocker_hash(const char*, size_t);
+BlockFilter* blocker_load(gchar**);
+gboolean blocker_map(BlockFilter*, const char*);
+gboolean blocker_match(BlockFilter*, const char*);
+void blocker_pad(GString*);
+gpointer blocker_thread(gpointer);
 void change_mode(int);
+Tab* bridge_tab(JSObjectRef);
 void close_tab(int);
+gint compare_script_profiles(gconstpointer, gconstpointer);
+void compile_script_patterns(ScriptList*);
+void remove_tab(Tab*);
+void connect_view(WebKitWebView*, Tab*);
+char* cookies_base_domain(const char*);
+GHashTable* cookies_collect();
+void cookies_import(const char*, const char*);
+void cookies_load(const char*);
+gpointer cookies_thread(gpointer);
+void cookies_write(GHashTable*);
 GtkWidget* create_tab(char*, gboolean);
+WebKitWebView* create_view(Tab*);
 void eval_marker(int);
+void free_request_timing(gpointer);
+void free_script_profile(gpointer);
+JSValueRef evaluate_script(JSContextRef, JSStringRef, const char*, const char*, JSValueRef*);
+JSStringRef get_script_source(ScriptList*);
+void invalidate_script_source(ScriptList*);
+gboolean flush_status(gpointer);
+const char* get_hiding_stylesheet(const char*, const char*);
+JSValueRef hints_call(JSObjectRef, int, int);
+void hints_clear();
+void hints_filter(const char*, gboolean);
+int hints_focus(int);
+char* hints_follow(int);
+JSObjectRef hints_method(JSContextRef, const char*);
+void hints_reset();
+gboolean hints_show();
+void apply_hiding_stylesheet(Tab*, const char*);
 void init_data();
+void install_bridge(JSContextRef, Tab*);
+gboolean is_offline_request(SoupMessage*);
 void init_directories();
 void init_jumanji();
 void init_keylist();
 void init_settings();
 void init_ui();
-void load_all_scripts();
+void mark_dirty(int);
+void mark_dirty_throttled(int);
+void mark_tab_dirty(Tab*);
+void match_scripts(Tab*, const char*);
+void queue_tab_label(Tab*);
+gint64 resident_memory();
 void notify(int, char*);
+void json_append_date(GString*, gint64);
+void json_append_number(GString*, const char*, double);
+void json_append_string(GString*, const char*);
 void new_window(char*);
 void out_of_memory();
 void open_uri(WebKitWebView*, char*);
+gchar** parse_line(char*, int*);
+void prerender_drop(Tab*);
+void prerender_start(Tab*);
+void prerender_swap(Tab*);
+void profile_script(const char*, const char*, gint64, gboolean);
 void read_configuration();
+void record_command(const char*);
+void record_request(Tab*, WebKitWebView*, WebKitWebFrame*, WebKitNetworkRequest*, WebKitNetworkResponse*);
+void record_key(GdkEventKey*);
 char* read_file(const char*);
 char* reference_to_string(JSContextRef, JSValueRef);
-void run_script(char*, char**, char**);
+gboolean run_command(char*);
+void run_script(char*, const char*, char**, char**);
+gboolean replay_start(char*);
+gboolean replay_step(gpointer);
+gboolean standin_start(char*);
 gboolean search_and_highlight(Argument*);
 gboolean sessionload(char*);
 gboolean sessionsave(char*);
 gboolean sessionswitch(char*);
 void set_completion_row_color(GtkBox*, int, int);
+void set_link(const char*);
+void set_style(GtkWidget*, const char*);
+void speculate(const char*);
 void switch_view(GtkWidget*);
+double timing_span(gint64, gint64);
+guint32 trie_child(GArray*, guint32, guint8);
 void update_status();
 void update_uri();
 void update_position();
+void update_tab_label(Tab*, gboolean);
+void update_tab_slot(TabSlot*, Tab*, gboolean);
 GtkEventBox* create_completion_row(GtkBox*, char*, char*, gboolean);
 
 Completion* completion_init();
@@ -406,6 +680,7 @@ void sc_run_script(Argument*);
 void sc_scroll(Argument*);
 void sc_search(Argument*);
 void sc_spawn(Argument*);
+void sc_toggle_offline(Argument*);
 void sc_toggle_proxy(Argument*);
 void sc_toggle_statusbar(Argument*);
 void sc_toggle_sourcecode(Argument*);
@@ -422,18 +697,24 @@ void isc_string_manipulation(Argument*);
 
 /* command declarations */
 gboolean cmd_back(int, char**);
+gboolean cmd_block(int, char**);
 gboolean cmd_bmap(int, char**);
 gboolean cmd_bookmark(int, char**);
+gboolean cmd_cache(int, char**);
 gboolean cmd_forward(int, char**);
+gboolean cmd_har(int, char**);
+gboolean cmd_hide(int, char**);
 gboolean cmd_map(int, char**);
 gboolean cmd_open(int, char**);
 gboolean cmd_print(int, char**);
+gboolean cmd_profile(int, char**);
 gboolean cmd_quit(int, char**);
 gboolean cmd_quitall(int, char**);
 gboolean cmd_reload(int, char**);
 gboolean cmd_reload_all(int, char**);
 gboolean cmd_saveas(int, char**);
 gboolean cmd_script(int, char**);
+gboolean cmd_source(int, char**);
 gboolean cmd_search_engine(int, char**);
 gboolean cmd_sessionload(int, char**);
 gboolean cmd_sessionsave(int, char**);
@@ -468,22 +749,48 @@ gboolean scmd_search(char*, Argument*, gboolean);
 /* callback declarations */
 UniqueResponse cb_app_message_received(UniqueApp*, gint, UniqueMessageData*, guint, gpointer);
 gboolean cb_blank();
+gboolean cb_blocker_build(gpointer);
+gboolean cb_blocker_ready(gpointer);
+void cb_clipboard_paste(GtkClipboard*, const gchar*, gpointer);
+JSValueRef cb_js_mode(JSContextRef, JSObjectRef, JSObjectRef, size_t, const JSValueRef[], JSValueRef*);
 gboolean cb_destroy(GtkWidget*, gpointer);
+gboolean cb_gc_pass(gpointer);
+gboolean cb_gc_step(gpointer);
+gboolean cb_hints_rescan(gpointer);
+void cb_script_changed(GFileMonitor*, GFile*, GFile*, GFileMonitorEvent, gpointer);
+void cb_cookie_changed(SoupCookieJar*, SoupCookie*, SoupCookie*, gpointer);
+gboolean cb_cookies_flush(gpointer);
+gboolean cb_cookies_flushed(gpointer);
+void cb_soup_got_chunk(SoupMessage*, SoupBuffer*, gpointer);
+void cb_soup_got_headers(SoupMessage*, gpointer);
+void cb_soup_network_event(SoupMessage*, GSocketClientEvent, GIOStream*, gpointer);
+void cb_soup_request_queued(SoupSession*, SoupMessage*, gpointer);
+void cb_soup_request_started(SoupSession*, SoupMessage*, SoupSocket*, gpointer);
+void cb_soup_timing(SoupMessage*, gpointer);
+void cb_soup_timing_finished(SoupMessage*, gpointer);
+gboolean cb_prerender_free(gpointer);
+gboolean cb_speculate_hover(gpointer);
+void cb_speculate_prefetched(SoupSession*, SoupMessage*, gpointer);
 gboolean cb_inputbar_kb_pressed(GtkWidget*, GdkEventKey*, gpointer);
 void cb_inputbar_changed(GtkEditable*, gpointer);
 gboolean cb_inputbar_activate(GtkEntry*, gpointer);
+void cb_notebook_switch_page(GtkNotebook*, gpointer, guint, gpointer);
+void cb_standin_request(SoupServer*, SoupMessage*, const char*, GHashTable*, SoupClientContext*, gpointer);
 gboolean cb_tab_kb_pressed(GtkWidget*, GdkEventKey*, gpointer);
 gboolean cb_tab_clicked(GtkWidget*, GdkEventButton*, gpointer);
+gboolean cb_status_throttle(gpointer);
 gboolean cb_wv_button_release_event(GtkWidget*, GdkEvent*, gpointer);
-gboolean cb_wv_console(WebKitWebView*, char*, int, char*, gpointer);
 GtkWidget* cb_wv_create_web_view(WebKitWebView*, WebKitWebFrame*, gpointer);
 gboolean cb_wv_download_request(WebKitWebView*, WebKitDownload*, gpointer);
 gboolean cb_wv_hover_link(WebKitWebView*, char*, char*, gpointer);
+gboolean cb_wv_kb_pressed(GtkWidget*, GdkEventKey*, gpointer);
 WebKitWebView* cb_wv_inspector_view(WebKitWebInspector*, WebKitWebView*, gpointer);
 gboolean cb_wv_mimetype_policy_decision(WebKitWebView*, WebKitWebFrame*, WebKitNetworkRequest*, char*, WebKitWebPolicyDecision*, gpointer);
+gboolean cb_wv_notify_load_status(WebKitWebView*, GParamSpec*, gpointer);
 gboolean cb_wv_notify_progress(WebKitWebView*, GParamSpec*, gpointer);
 gboolean cb_wv_notify_title(WebKitWebView*, GParamSpec*, gpointer);
 gboolean cb_wv_nav_policy_decision(WebKitWebView*, WebKitWebFrame*, WebKitNetworkRequest*, WebKitWebNavigationAction*, WebKitWebPolicyDecision*, gpointer);
+void cb_wv_resource_request(WebKitWebView*, WebKitWebFrame*, WebKitWebResource*, WebKitNetworkRequest*, WebKitNetworkResponse*, gpointer);
 gboolean cb_wv_scrolled(GtkAdjustment*, gpointer);
 gboolean cb_wv_window_policy_decision(WebKitWebView*, WebKitWebFrame*, WebKitNetworkRequest*, WebKitWebNavigationAction*, WebKitWebPolicyDecision*, gpointer);
 gboolean cb_wv_window_object_cleared(WebKitWebView*, WebKitWebFrame*, gpointer, gpointer, gpointer);
@@ -504,7 +811,7 @@ add_marker(int id)
   adjustment = gtk_scrolled_window_get_hadjustment(GET_CURRENT_TAB_WIDGET());
   gdouble ha = gtk_adjustment_get_value(adjustment);
   float zl   = webkit_web_view_get_zoom_level(GET_CURRENT_TAB());
-  int ti     = gtk_notebook_get_current_page(Jumanji.UI.view);
+  int ti     = Jumanji.Tabs.current->id;
 
   /* search if entry already exists */
   GList* list;
@@ -542,3488 +849,6747 @@ auto_save(gpointer UNUSED(data))
 }
 
 void
-change_mode(int mode)
+batch_begin()
 {
-  char* mode_text = NULL;
-
-  switch(mode)
-  {
-    case INSERT:
-      mode_text = "-- INSERT --";
-      break;
-    case VISUAL:
-      mode_text = "-- VISUAL --";
-      break;
-    case ADD_MARKER:
-      mode_text = "";
-      break;
-    case EVAL_MARKER:
-      mode_text = "";
-      break;
-    case FOLLOW:
-      mode_text = "Follow hint: ";
-      break;
-    case PASS_THROUGH:
-      mode_text = "-- PASS THROUGH --";
-      break;
-    case PASS_THROUGH_NEXT:
-      mode_text = "-- PASS THROUGH (next)--";
-      break;
-    default:
-      mode_text = "";
-      mode      = NORMAL;
-      break;
-  }
-
-  Jumanji.Global.mode = mode;
-  notify(DEFAULT, mode_text);
+  Jumanji.Batch.depth++;
 }
 
 void
-close_tab(int tab_id)
+batch_end()
 {
-  GtkWidget* tab = GTK_WIDGET(GET_NTH_TAB_WIDGET(tab_id));
-
-  /* remove markers for this tab
-   * and update the others */
-  GList* list = Jumanji.Global.markers;
-  while (list) {
-    Marker* marker = (Marker*) list->data;
-    GList* next_marker = g_list_next(list);
+  if(Jumanji.Batch.depth <= 0 || --Jumanji.Batch.depth > 0)
+    return;
 
-    if (marker->tab_id == tab_id) {
-      Jumanji.Global.markers = g_list_delete_link(Jumanji.Global.markers, list);
-      free(marker);
-    } else if (marker->tab_id > tab_id) {
-      marker->tab_id -= 1;
-    }
+  /* apply everything that has been deferred while the batch was running */
+  if(Jumanji.Batch.reload)
+  {
+    Jumanji.Batch.reload = FALSE;
 
-    list = next_marker;
+    if(Jumanji.Tabs.current)
+      webkit_web_view_reload(GET_CURRENT_TAB());
   }
 
-  gchar *uri = g_strdup((gchar *) webkit_web_view_get_uri(GET_CURRENT_TAB()));
-  Jumanji.Global.last_closed = g_list_prepend(Jumanji.Global.last_closed, uri);
+  if(Jumanji.Statusbar.dirty)
+    mark_dirty(0);
 
-  if (gtk_notebook_get_n_pages(Jumanji.UI.view) > 1) {
-    gtk_container_remove(GTK_CONTAINER(Jumanji.UI.tabbar), GTK_WIDGET(g_object_get_data(G_OBJECT(tab), "tab")));
-    gtk_notebook_remove_page(Jumanji.UI.view, tab_id);
-    update_status();
-  } else {
-    cb_destroy(NULL, NULL);
+  if(Jumanji.Batch.notify_message)
+  {
+    char* message = Jumanji.Batch.notify_message;
+    Jumanji.Batch.notify_message = NULL;
+
+    notify(Jumanji.Batch.notify_level, message);
+    g_free(message);
   }
 }
 
-GtkWidget*
-create_tab(char* uri, gboolean background)
+BlockFilter*
+blocker_compile(gchar** paths, const char* signature)
 {
-  if(!uri)
-    return NULL;
-
-  GtkWidget *tab = gtk_scrolled_window_new(NULL, NULL);
-  GtkWidget *wv  = webkit_web_view_new();
+  GHashTable* domains  = g_hash_table_new(g_str_hash, g_str_equal);
+  GPtrArray*  patterns = g_ptr_array_new();
+  GPtrArray*  contents = g_ptr_array_new_with_free_func(g_free);
 
-  if(!tab || !wv)
-    return NULL;
-
-  int number_of_tabs = gtk_notebook_get_current_page(Jumanji.UI.view);
-  int position       = (next_to_current) ? (number_of_tabs + 1) : -1;
-
-  if(show_scrollbars)
-    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(tab), GTK_POLICY_AUTOMATIC, GTK_POLICY_AUTOMATIC);
-  else
+  /* hosts files and the network rules of adblock lists, rules with options
+   * or wildcards within the pattern and exceptions are skipped */
+  for(gchar** path = paths; *path; path++)
   {
-    WebKitWebFrame* mf = webkit_web_view_get_main_frame(WEBKIT_WEB_VIEW(wv));
-    g_signal_connect(G_OBJECT(mf),  "scrollbars-policy-changed", G_CALLBACK(cb_blank), NULL);
+    gchar* content = NULL;
+    if(!g_file_get_contents(*path, &content, NULL, NULL))
+      continue;
 
-    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(tab), GTK_POLICY_NEVER, GTK_POLICY_NEVER);
-  }
+    gchar** lines = g_strsplit(content, "\n", -1);
+    g_free(content);
 
-  GtkAdjustment* adjustment = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(tab));
+    for(gchar** line = lines; *line; line++)
+    {
+      char* rule = g_strstrip(g_ascii_strdown(*line, -1));
+      g_ptr_array_add(contents, rule);
 
-  /* connect webview callbacks */
-  g_signal_connect(G_OBJECT(wv),  "console-message",                      G_CALLBACK(cb_wv_console),                  NULL);
-  g_signal_connect(G_OBJECT(wv),  "create-web-view",                      G_CALLBACK(cb_wv_create_web_view),          NULL);
-  g_signal_connect(G_OBJECT(wv),  "download-requested",                   G_CALLBACK(cb_wv_download_request),         NULL);
-  g_signal_connect(G_OBJECT(wv),  "button-release-event",                 G_CALLBACK(cb_wv_button_release_event),     NULL);
-  g_signal_connect(G_OBJECT(wv),  "hovering-over-link",                   G_CALLBACK(cb_wv_hover_link),               NULL);
-  g_signal_connect(G_OBJECT(wv),  "mime-type-policy-decision-requested",  G_CALLBACK(cb_wv_mimetype_policy_decision), NULL);
-  g_signal_connect(G_OBJECT(wv),  "navigation-policy-decision-requested", G_CALLBACK(cb_wv_nav_policy_decision),      NULL);
-  g_signal_connect(G_OBJECT(wv),  "new-window-policy-decision-requested", G_CALLBACK(cb_wv_window_policy_decision),   NULL);
-  g_signal_connect(G_OBJECT(wv),  "notify::progress",                     G_CALLBACK(cb_wv_notify_progress),          NULL);
-  g_signal_connect(G_OBJECT(wv),  "notify::title",                        G_CALLBACK(cb_wv_notify_title),             NULL);
-  g_signal_connect(G_OBJECT(wv),  "window-object-cleared",                G_CALLBACK(cb_wv_window_object_cleared),    NULL);
+      if(!*rule || *rule == '!' || *rule == '#' || *rule == '[' || !strncmp(rule, "@@", 2)
+          || strstr(rule, "##") || strstr(rule, "#@#") || strchr(rule, '$'))
+        continue;
 
-  /* connect tab callbacks */
-  g_signal_connect(G_OBJECT(tab),        "key-press-event", G_CALLBACK(cb_tab_kb_pressed), NULL);
-  g_signal_connect(G_OBJECT(adjustment), "value-changed",   G_CALLBACK(cb_wv_scrolled),    NULL);
+      /* hosts file entries start with an address */
+      if(strspn(rule, "0123456789.:") && g_ascii_isspace(rule[strspn(rule, "0123456789.:")]))
+      {
+        rule = g_strchug(rule + strspn(rule, "0123456789.:"));
+        rule[strcspn(rule, " \t#")] = '\0';
 
-  /* set default values */
-  g_object_set_data(G_OBJECT(wv), "loaded_scripts", 0);
-  g_object_set(G_OBJECT(wv), "full-content-zoom", full_content_zoom, NULL);
+        if(*rule && strcmp(rule, "localhost") && strcmp(rule, "localhost.localdomain")
+            && strcmp(rule, "broadcasthost") && strcmp(rule, "0.0.0.0"))
+          g_hash_table_insert(domains, rule, rule);
+        continue;
+      }
 
-  /* apply browser setting */
-  webkit_web_view_set_settings(WEBKIT_WEB_VIEW(wv), webkit_web_settings_copy(Jumanji.Global.browser_settings));
+      /* anchors and separators at the ends are dropped */
+      if(!strncmp(rule, "||", 2))
+        rule += 2;
+      else if(*rule == '|')
+        rule++;
+
+      size_t length = strlen(rule);
+      if(length && rule[length - 1] == '|')
+        rule[--length] = '\0';
+      if(length && rule[length - 1] == '^')
+        rule[--length] = '\0';
+      while(*rule == '*')
+        rule++;
+      length = strlen(rule);
+      while(length && rule[length - 1] == '*')
+        rule[--length] = '\0';
+
+      /* plain domains go into the domain set */
+      if(length && strspn(rule, "abcdefghijklmnopqrstuvwxyz0123456789.-") == length && strchr(rule, '.'))
+        g_hash_table_insert(domains, rule, rule);
+      else if(length >= 4 && !strpbrk(rule, "*^|"))
+        g_ptr_array_add(patterns, rule);
+    }
 
-  /* set web inspector */
-  WebKitWebInspector* web_inspector = webkit_web_view_get_inspector(WEBKIT_WEB_VIEW(wv));
-  g_signal_connect(G_OBJECT(web_inspector), "inspect-web-view", G_CALLBACK(cb_wv_inspector_view), NULL);
+    g_strfreev(lines);
+  }
 
-  gtk_container_add(GTK_CONTAINER(tab), wv);
-  gtk_widget_show_all(tab);
-  gtk_notebook_insert_page(Jumanji.UI.view, tab, NULL, position);
+  /* domain set: open addressing over offsets into a string table */
+  guint32 n_buckets = 1;
+  while(n_buckets < 2 * g_hash_table_size(domains))
+    n_buckets <<= 1;
 
-  if(!background)
-    gtk_notebook_set_current_page(Jumanji.UI.view, position);
+  guint32* buckets = g_new0(guint32, n_buckets);
+  GString* strings = g_string_new(NULL);
+  GList*   keys    = g_hash_table_get_keys(domains);
 
-  /* create tab label */
-  GtkWidget *tab_label = gtk_label_new(NULL);
-  gtk_label_set_width_chars(GTK_LABEL(tab_label), 1.0);
-  gtk_misc_set_alignment(    GTK_MISC(tab_label), 0.0, 0.0);
-  gtk_misc_set_padding(      GTK_MISC(tab_label), 4.0, 4.0);
+  for(GList* l = keys; l; l = g_list_next(l))
+  {
+    const char* domain = (const char*) l->data;
+    guint32 bucket = blocker_hash(domain, strlen(domain)) & (n_buckets - 1);
 
-  /* create tab container */
-  GtkWidget *tev_box = gtk_event_box_new();
-  GtkWidget *tab_box = gtk_hbox_new(FALSE, 0);
-  GtkWidget *tab_sep = gtk_vseparator_new();
+    while(buckets[bucket])
+      bucket = (bucket + 1) & (n_buckets - 1);
 
-  /* tab style */
-  gtk_widget_modify_font(tab_label, Jumanji.Style.font);
-  gtk_widget_modify_bg(tab_sep,  GTK_STATE_NORMAL, &(Jumanji.Style.tabbar_separator));
+    buckets[bucket] = strings->len + 1;
+    g_string_append_len(strings, domain, strlen(domain) + 1);
+  }
 
-  /* build tab */
-  gtk_box_pack_start(GTK_BOX(tab_box), tab_label,  TRUE,  TRUE, 0);
-  gtk_box_pack_start(GTK_BOX(tab_box), tab_sep,   FALSE, FALSE, 0);
-  gtk_container_add(GTK_CONTAINER(tev_box), tab_box);
+  g_list_free(keys);
 
-  /* tab clickable */
-  g_signal_connect(GTK_OBJECT(tev_box), "button_press_event", G_CALLBACK(cb_tab_clicked), tab);
+  /* url patterns: aho-corasick automaton, built as a trie of siblings */
+  GArray* trie = g_array_new(FALSE, TRUE, sizeof(TrieNode));
+  g_array_set_size(trie, 1);
 
-  /* add to tabbar */
-  gtk_box_pack_start(GTK_BOX(Jumanji.UI.tabbar), tev_box, TRUE, TRUE, 0);
-  gtk_box_reorder_child(GTK_BOX(Jumanji.UI.tabbar), tev_box, position);
-  gtk_widget_show_all(tev_box);
+  for(unsigned int i = 0; i < patterns->len; i++)
+  {
+    guint32 node = 0;
 
-  /* add reference to tab */
-  g_object_set_data(G_OBJECT(tab), "tab",   (gpointer) tev_box);
-  g_object_set_data(G_OBJECT(tab), "label", (gpointer) tab_label);
+    for(const guint8* c = g_ptr_array_index(patterns, i); *c; c++)
+    {
+      guint32 child = trie_child(trie, node, *c);
 
-  gtk_widget_grab_focus(GTK_WIDGET(GET_CURRENT_TAB_WIDGET()));
+      if(!child)
+      {
+        TrieNode new_node = { 0, g_array_index(trie, TrieNode, node).child, *c, 0 };
+        child = trie->len;
+        g_array_append_val(trie, new_node);
+        g_array_index(trie, TrieNode, node).child = child;
+      }
 
-  /* open uri */
-  open_uri(WEBKIT_WEB_VIEW(wv), uri);
+      node = child;
+    }
 
-  return wv;
-}
+    g_array_index(trie, TrieNode, node).out = 1;
+  }
 
+  guint32  n_states = trie->len;
+  guint32* fail     = g_new0(guint32, n_states);
+  guint32* queue    = g_new(guint32, n_states);
+  guint32  head = 0, tail = 0;
 
-void
-eval_marker(int id)
-{
-  if((id < 0x30) || (id > 0x7A))
-    return;
+  queue[tail++] = 0;
 
-  GList* list;
-  for(list = Jumanji.Global.markers; list; list = g_list_next(list))
+  while(head < tail)
   {
-    Marker* marker = (Marker*) list->data;
+    guint32 node = queue[head++];
 
-    if(marker->id == id)
+    for(guint32 child = g_array_index(trie, TrieNode, node).child; child; child = g_array_index(trie, TrieNode, child).sibling)
     {
-      gtk_notebook_set_current_page(Jumanji.UI.view, marker->tab_id);
-      GtkAdjustment* adjustment;
-      adjustment = gtk_scrolled_window_get_vadjustment(GET_CURRENT_TAB_WIDGET());
-      gtk_adjustment_set_value(adjustment, marker->vadjustment);
-      adjustment = gtk_scrolled_window_get_hadjustment(GET_CURRENT_TAB_WIDGET());
-      gtk_adjustment_set_value(adjustment, marker->hadjustment);
-      webkit_web_view_set_zoom_level(GET_CURRENT_TAB(), marker->zoom_level);
-      update_status();
-      return;
+      guint8 c = g_array_index(trie, TrieNode, child).c;
+      guint32 target = 0;
+
+      /* longest proper suffix that is also in the trie */
+      for(guint32 state = fail[node]; node; state = fail[state])
+      {
+        if((target = trie_child(trie, state, c)) || !state)
+          break;
+      }
+
+      fail[child] = target;
+      g_array_index(trie, TrieNode, child).out |= g_array_index(trie, TrieNode, target).out;
+      queue[tail++] = child;
     }
   }
-}
-
-void
-init_data()
-{
-  /* read bookmarks */
-  char* bookmark_file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_BOOKMARKS, NULL);
 
-  if(!bookmark_file)
-    return;
+  /* flat edge lists, sorted by character for a binary search */
+  guint32* first_edge  = g_new0(guint32, n_states + 1);
+  guint32* edge_target = g_new(guint32, MAX(n_states, 1));
+  guint8*  edge_char   = g_new(guint8, MAX(n_states, 1));
+  guint8*  out         = g_new(guint8, n_states);
+  guint32  n_edges     = 0;
 
-  if(g_file_test(bookmark_file, G_FILE_TEST_IS_REGULAR))
+  for(guint32 state = 0; state < n_states; state++)
   {
-    char* content = NULL;
+    first_edge[state] = n_edges;
+    out[state]        = g_array_index(trie, TrieNode, state).out;
 
-    if(g_file_get_contents(bookmark_file, &content, NULL, NULL))
+    for(guint32 child = g_array_index(trie, TrieNode, state).child; child; child = g_array_index(trie, TrieNode, child).sibling)
     {
-      gchar **lines = g_strsplit(content, "\n", -1);
-      int     n     = g_strv_length(lines) - 1;
+      guint8 c = g_array_index(trie, TrieNode, child).c;
+      guint32 e = n_edges++;
 
-      int i;
-      for(i = 0; i < n; i++)
+      for(; e > first_edge[state] && edge_char[e - 1] > c; e--)
       {
-        if(!strlen(lines[i]))
-          continue;
-
-        Jumanji.Global.bookmarks = g_list_append(Jumanji.Global.bookmarks, lines[i]);
+        edge_char[e]   = edge_char[e - 1];
+        edge_target[e] = edge_target[e - 1];
       }
 
-      g_free(content);
-      g_free(lines);
+      edge_char[e]   = c;
+      edge_target[e] = child;
     }
   }
 
-  g_free(bookmark_file);
+  first_edge[n_states] = n_edges;
+
+  /* everything goes into one block with the layout of the cache file */
+  guint32 header[6] = { BLOCKER_MAGIC, strlen(signature), n_buckets, strings->len, n_states, n_edges };
+  GString* data = g_string_new(NULL);
+
+  g_string_append_len(data, (char*) header, sizeof(header));
+  g_string_append_len(data, signature, header[1]);
+  blocker_pad(data);
+  g_string_append_len(data, (char*) buckets, n_buckets * sizeof(guint32));
+  g_string_append_len(data, strings->str, strings->len);
+  blocker_pad(data);
+  g_string_append_len(data, (char*) first_edge, (n_states + 1) * sizeof(guint32));
+  g_string_append_len(data, (char*) edge_target, n_edges * sizeof(guint32));
+  g_string_append_len(data, (char*) fail, n_states * sizeof(guint32));
+  g_string_append_len(data, (char*) edge_char, n_edges);
+  blocker_pad(data);
+  g_string_append_len(data, (char*) out, n_states);
+  blocker_pad(data);
+
+  g_free(buckets);
+  g_string_free(strings, TRUE);
+  g_array_free(trie, TRUE);
+  g_free(fail);
+  g_free(queue);
+  g_free(first_edge);
+  g_free(edge_target);
+  g_free(edge_char);
+  g_free(out);
+  g_hash_table_destroy(domains);
+  g_ptr_array_free(patterns, TRUE);
+  g_ptr_array_free(contents, TRUE);
+
+  BlockFilter* filter = g_malloc0(sizeof(BlockFilter));
+  filter->length = data->len;
+  filter->data   = g_string_free(data, FALSE);
+
+  if(!blocker_map(filter, signature))
+  {
+    blocker_free(filter);
+    return NULL;
+  }
 
-  /* read history */
-  char* history_file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_HISTORY, NULL);
+  return filter;
+}
 
-  if(!history_file)
+void
+blocker_free(BlockFilter* filter)
+{
+  if(!filter)
     return;
 
-  if(g_file_test(history_file, G_FILE_TEST_IS_REGULAR))
-  {
-    char* content = NULL;
+  if(filter->mapped)
+    g_mapped_file_unref(filter->mapped);
+  else
+    g_free(filter->data);
 
-    if(g_file_get_contents(history_file, &content, NULL, NULL))
-    {
-      gchar **lines = g_strsplit(content, "\n", -1);
-      int     n     = g_strv_length(lines) - 1;
+  g_free(filter);
+}
 
-      int i;
-      for(i = 0; i < n; i++)
-      {
-        if(!strlen(lines[i]))
-          continue;
+guint32
+blocker_hash(const char* string, size_t length)
+{
+  guint32 hash = 5381;
 
-        Jumanji.Global.history = g_list_prepend(Jumanji.Global.history, lines[i]);
-      }
+  for(size_t i = 0; i < length; i++)
+    hash = hash * 33 + (guint8) string[i];
 
-      Jumanji.Global.history = g_list_reverse(Jumanji.Global.history);
+  return hash;
+}
 
-      g_free(content);
-      g_free(lines);
-    }
+BlockFilter*
+blocker_load(gchar** paths)
+{
+  /* the cache is only valid for the same lists in the same versions */
+  GString* signature = g_string_new(NULL);
+
+  for(gchar** path = paths; *path; path++)
+  {
+    struct stat info;
+    if(!stat(*path, &info))
+      g_string_append_printf(signature, "%s\t%ld\t%ld\n", *path, (long) info.st_mtime, (long) info.st_size);
   }
 
-  g_free(history_file);
+  char* cache = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_BLOCKLIST, NULL);
+  BlockFilter* filter = g_malloc0(sizeof(BlockFilter));
 
-  /* read sessions */
-  gchar* sessions_file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_SESSIONS, NULL);
+  filter->mapped = g_mapped_file_new(cache, FALSE, NULL);
 
-  if(!sessions_file)
-    return;
+  if(filter->mapped)
+  {
+    filter->data   = g_mapped_file_get_contents(filter->mapped);
+    filter->length = g_mapped_file_get_length(filter->mapped);
+  }
 
-  if(g_file_test(sessions_file, G_FILE_TEST_IS_REGULAR))
+  if(!filter->mapped || !blocker_map(filter, signature->str))
   {
-    char* content = NULL;
+    blocker_free(filter);
 
-    if(g_file_get_contents(sessions_file, &content, NULL, NULL))
-    {
-      gchar **lines = g_strsplit(content, "\n", -1);
-      int     n     = g_strv_length(lines) - 1;
+    if((filter = blocker_compile(paths, signature->str)))
+      g_file_set_contents(cache, filter->data, filter->length, NULL);
+  }
 
-      for(int i = 0; i < n; i+=2)
-      {
-        if(!strlen(lines[i]) || !strlen(lines[i+1]))
-          continue;
+  g_free(cache);
+  g_string_free(signature, TRUE);
 
-        Session* se = malloc(sizeof(Session));
-        se->name = lines[i];
-        se->uris = lines[i+1];
+  return filter;
+}
 
-        Jumanji.Global.sessions = g_list_prepend(Jumanji.Global.sessions, se);
-      }
+gboolean
+blocker_map(BlockFilter* filter, const char* signature)
+{
+  const guint32* header = (const guint32*) filter->data;
+  gsize offset = 6 * sizeof(guint32);
 
-      g_free(content);
-      g_free(lines);
-    }
+  if(filter->length < offset || header[0] != BLOCKER_MAGIC || header[1] != strlen(signature))
+    return FALSE;
+
+  if(filter->length < offset + header[1] || memcmp(filter->data + offset, signature, header[1]))
+    return FALSE;
+
+  filter->n_buckets = header[2];
+  filter->n_states  = header[4];
+
+  gsize sizes[] = {
+    (header[1] + 3) & ~3,
+    header[2] * sizeof(guint32),
+    (header[3] + 3) & ~3,
+    (header[4] + 1) * sizeof(guint32),
+    header[5] * sizeof(guint32),
+    header[4] * sizeof(guint32),
+    (header[5] + 3) & ~3,
+    (header[4] + 3) & ~3
+  };
+
+  const char* parts[LENGTH(sizes)];
+
+  for(unsigned int i = 0; i < LENGTH(sizes); i++)
+  {
+    parts[i] = filter->data + offset;
+    offset  += sizes[i];
   }
 
-  g_free(sessions_file);
+  if(filter->length < offset || !filter->n_buckets || !filter->n_states)
+    return FALSE;
 
-  /* load cookies */
-  char* cookie_file        = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_COOKIES, NULL);
-  SoupCookieJar *cookiejar = soup_cookie_jar_text_new(cookie_file, FALSE);
+  filter->buckets     = (const guint32*) parts[1];
+  filter->strings     = parts[2];
+  filter->first_edge  = (const guint32*) parts[3];
+  filter->edge_target = (const guint32*) parts[4];
+  filter->fail        = (const guint32*) parts[5];
+  filter->edge_char   = (const guint8*) parts[6];
+  filter->out         = (const guint8*) parts[7];
 
-  soup_session_add_feature(Jumanji.Soup.session, (SoupSessionFeature*) cookiejar);
-  g_free(cookie_file);
+  return TRUE;
 }
 
-void
-init_directories()
+gboolean
+blocker_match(BlockFilter* filter, const char* uri)
 {
-  /* create jumanji directory */
-  gchar *base_directory = g_build_filename(g_get_home_dir(), JUMANJI_DIR, NULL);
-  g_mkdir_with_parents(base_directory,  0771);
-  g_free(base_directory);
-}
+  if(!filter || !uri)
+    return FALSE;
 
-void
-init_keylist()
-{
-  /* init shortcuts */
-  ShortcutList* e = NULL;
-  ShortcutList* p = NULL;
+  /* host and its parent domains in the domain set */
+  const char* host = strstr(uri, "://");
+  host = host ? host + 3 : uri;
+  size_t length = strcspn(host, "/?#:");
+  char buffer[256];
 
-  for(unsigned int i = 0; i < LENGTH(shortcuts); i++)
+  if(length < sizeof(buffer))
   {
-    e = malloc(sizeof(ShortcutList));
-    if(!e)
-      out_of_memory();
+    for(size_t i = 0; i < length; i++)
+      buffer[i] = g_ascii_tolower(host[i]);
+    buffer[length] = '\0';
 
-    e->element = shortcuts[i];
-    e->next    = NULL;
+    const char* domain = buffer;
 
-    if(!Jumanji.Bindings.sclist)
-      Jumanji.Bindings.sclist = e;
-    if(p)
-      p->next = e;
+    while(domain)
+    {
+      size_t  n      = length - (domain - buffer);
+      guint32 bucket = blocker_hash(domain, n) & (filter->n_buckets - 1);
 
-    p = e;
+      for(; filter->buckets[bucket]; bucket = (bucket + 1) & (filter->n_buckets - 1))
+        if(!strcmp(filter->strings + filter->buckets[bucket] - 1, domain))
+          return TRUE;
+
+      if((domain = strchr(domain, '.')))
+        domain++;
+    }
   }
 
-  /* init buffered commands */
-  BufferCommandList *b = NULL;
-  BufferCommandList *f = NULL;
+  /* url patterns */
+  guint32 state = 0;
 
-  for(unsigned int i = 0; i < LENGTH(buffer_commands); i++)
+  for(const char* c = uri; *c; c++)
   {
-    b = malloc(sizeof(BufferCommandList));
-    if(!b)
-      out_of_memory();
+    guint8  character = g_ascii_tolower(*c);
+    guint32 next      = 0;
 
-    b->element = buffer_commands[i];
-    b->next    = NULL;
+    while(TRUE)
+    {
+      guint32 low  = filter->first_edge[state];
+      guint32 high = filter->first_edge[state + 1];
 
-    if(!Jumanji.Bindings.bcmdlist)
-      Jumanji.Bindings.bcmdlist = b;
-    if(f)
-      f->next = b;
+      while(low < high)
+      {
+        guint32 middle = (low + high) / 2;
+        if(filter->edge_char[middle] < character)
+          low = middle + 1;
+        else
+          high = middle;
+      }
 
-    f = b;
+      if(low < filter->first_edge[state + 1] && filter->edge_char[low] == character)
+        next = filter->edge_target[low];
+
+      if(next || !state)
+        break;
+
+      state = filter->fail[state];
+    }
+
+    state = next;
+
+    if(filter->out[state])
+      return TRUE;
   }
+
+  return FALSE;
 }
 
 void
-init_settings()
+blocker_pad(GString* data)
 {
-  /* parse colors */
-  gdk_color_parse(default_fgcolor,        &(Jumanji.Style.default_fg));
-  gdk_color_parse(default_bgcolor,        &(Jumanji.Style.default_bg));
-  gdk_color_parse(inputbar_fgcolor,       &(Jumanji.Style.inputbar_fg));
-  gdk_color_parse(inputbar_bgcolor,       &(Jumanji.Style.inputbar_bg));
-  gdk_color_parse(statusbar_fgcolor,      &(Jumanji.Style.statusbar_fg));
-  gdk_color_parse(statusbar_bgcolor,      &(Jumanji.Style.statusbar_bg));
-  gdk_color_parse(statusbar_ssl_fgcolor,  &(Jumanji.Style.statusbar_ssl_fg));
-  gdk_color_parse(statusbar_ssl_bgcolor,  &(Jumanji.Style.statusbar_ssl_bg));
-  gdk_color_parse(tabbar_fgcolor,         &(Jumanji.Style.tabbar_fg));
-  gdk_color_parse(tabbar_bgcolor,         &(Jumanji.Style.tabbar_bg));
-  gdk_color_parse(tabbar_focus_fgcolor,   &(Jumanji.Style.tabbar_focus_fg));
-  gdk_color_parse(tabbar_focus_bgcolor,   &(Jumanji.Style.tabbar_focus_bg));
-  gdk_color_parse(tabbar_separator_color, &(Jumanji.Style.tabbar_separator));
-  gdk_color_parse(completion_fgcolor,     &(Jumanji.Style.completion_fg));
-  gdk_color_parse(completion_bgcolor,     &(Jumanji.Style.completion_bg));
-  gdk_color_parse(completion_g_fgcolor,   &(Jumanji.Style.completion_g_fg));
-  gdk_color_parse(completion_g_bgcolor,   &(Jumanji.Style.completion_g_bg));
-  gdk_color_parse(completion_hl_fgcolor,  &(Jumanji.Style.completion_hl_fg));
-  gdk_color_parse(completion_hl_bgcolor,  &(Jumanji.Style.completion_hl_bg));
-  gdk_color_parse(notification_e_fgcolor, &(Jumanji.Style.notification_e_fg));
-  gdk_color_parse(notification_e_bgcolor, &(Jumanji.Style.notification_e_bg));
-  gdk_color_parse(notification_w_fgcolor, &(Jumanji.Style.notification_w_fg));
-  gdk_color_parse(notification_w_bgcolor, &(Jumanji.Style.notification_w_bg));
-  Jumanji.Style.font = pango_font_description_from_string(font);
-
-  /* statusbar */
-  gtk_widget_modify_bg(GTK_WIDGET(Jumanji.UI.statusbar),       GTK_STATE_NORMAL, &(Jumanji.Style.statusbar_ssl_bg));
-  gtk_widget_modify_fg(GTK_WIDGET(Jumanji.Statusbar.text),     GTK_STATE_NORMAL, &(Jumanji.Style.statusbar_ssl_fg));
-  gtk_widget_modify_fg(GTK_WIDGET(Jumanji.Statusbar.buffer),   GTK_STATE_NORMAL, &(Jumanji.Style.statusbar_ssl_fg));
-  gtk_widget_modify_fg(GTK_WIDGET(Jumanji.Statusbar.tabs),     GTK_STATE_NORMAL, &(Jumanji.Style.statusbar_ssl_fg));
-  gtk_widget_modify_fg(GTK_WIDGET(Jumanji.Statusbar.position), GTK_STATE_NORMAL, &(Jumanji.Style.statusbar_ssl_fg));
+  while(data->len % 4)
+    g_string_append_c(data, '\0');
+}
 
-  gtk_widget_modify_font(GTK_WIDGET(Jumanji.Statusbar.text),     Jumanji.Style.font);
-  gtk_widget_modify_font(GTK_WIDGET(Jumanji.Statusbar.buffer),   Jumanji.Style.font);
-  gtk_widget_modify_font(GTK_WIDGET(Jumanji.Statusbar.tabs),     Jumanji.Style.font);
-  gtk_widget_modify_font(GTK_WIDGET(Jumanji.Statusbar.position), Jumanji.Style.font);
+gpointer
+blocker_thread(gpointer data)
+{
+  gchar** paths = (gchar**) data;
 
-  /* inputbar */
-  gtk_widget_modify_base(GTK_WIDGET(Jumanji.UI.inputbar), GTK_STATE_NORMAL, &(Jumanji.Style.inputbar_bg));
-  gtk_widget_modify_text(GTK_WIDGET(Jumanji.UI.inputbar), GTK_STATE_NORMAL, &(Jumanji.Style.inputbar_fg));
-  gtk_widget_modify_font(GTK_WIDGET(Jumanji.UI.inputbar),                     Jumanji.Style.font);
+  /* the result is handed over in the main loop */
+  g_idle_add(cb_blocker_ready, blocker_load(paths));
+  g_strfreev(paths);
 
-  /* set window size */
-  gtk_window_set_default_size(GTK_WINDOW(Jumanji.UI.window), default_width, default_height);
+  return NULL;
+}
 
-  /* set proxy */
-  sc_toggle_proxy(NULL);
+Tab*
+bridge_tab(JSObjectRef object)
+{
+  /* the bridge only knows the id of its tab, which may have been closed */
+  return object ? g_hash_table_lookup(Jumanji.Tabs.ids, JSObjectGetPrivate(object)) : NULL;
+}
 
-  /* apply user agent */
-  if(!user_agent && browser_name)
-  {
-    char* current_user_agent = NULL;
-    g_object_get(G_OBJECT(Jumanji.Global.browser_settings), "user-agent", &current_user_agent, NULL);
+void
+change_mode(int mode)
+{
+  char* mode_text = NULL;
 
-    char* new_user_agent = g_strconcat(current_user_agent, " ", browser_name, NULL);
-    g_object_set(G_OBJECT(Jumanji.Global.browser_settings), "user-agent", new_user_agent, NULL);
-    g_free(new_user_agent);
-  }
-  else if(user_agent)
+  switch(mode)
   {
-    g_object_set(G_OBJECT(Jumanji.Global.browser_settings), "user-agent", user_agent, NULL);
+    case INSERT:
+      mode_text = "-- INSERT --";
+      break;
+    case VISUAL:
+      mode_text = "-- VISUAL --";
+      break;
+    case ADD_MARKER:
+      mode_text = "";
+      break;
+    case EVAL_MARKER:
+      mode_text = "";
+      break;
+    case FOLLOW:
+      mode_text = "Follow hint: ";
+      break;
+    case PASS_THROUGH:
+      mode_text = "-- PASS THROUGH --";
+      break;
+    case PASS_THROUGH_NEXT:
+      mode_text = "-- PASS THROUGH (next)--";
+      break;
+    default:
+      mode_text = "";
+      mode      = NORMAL;
+      break;
   }
+
+  Jumanji.Global.mode = mode;
+  notify(DEFAULT, mode_text);
 }
 
 void
-load_all_scripts()
+close_tab(int tab_id)
 {
-  int ls = (size_t) g_object_get_data(G_OBJECT(GET_CURRENT_TAB()), "loaded_scripts");
+  /* markers of this tab are removed when they are evaluated */
+  gchar *uri = g_strdup((gchar *) webkit_web_view_get_uri(GET_CURRENT_TAB()));
+  Jumanji.Global.last_closed = g_list_prepend(Jumanji.Global.last_closed, uri);
 
-  if(!ls)
-  {
-    ScriptList* sl = Jumanji.Global.scripts;
-    while(sl)
-    {
-      run_script(sl->content, NULL, NULL);
-      sl = sl->next;
-    }
+  if (Jumanji.Tabs.list->len > 1) {
+    remove_tab(GET_TAB(tab_id));
+    update_status();
+  } else {
+    cb_destroy(NULL, NULL);
   }
-
-  g_object_set_data(G_OBJECT(GET_CURRENT_TAB()), "loaded_scripts",  (gpointer) 1);
 }
 
-void init_ui()
+void
+remove_tab(Tab* tab)
 {
-  /* window */
-  if(Jumanji.UI.embed)
-    Jumanji.UI.window = gtk_plug_new(Jumanji.UI.embed);
-  else
-    Jumanji.UI.window = gtk_window_new(GTK_WINDOW_TOPLEVEL);
+  int position = tab->position;
 
-  /* UI */
-  Jumanji.UI.box               = GTK_BOX(gtk_vbox_new(FALSE, 0));
-  Jumanji.UI.statusbar         = gtk_event_box_new();
-  Jumanji.UI.statusbar_entries = GTK_BOX(gtk_hbox_new(FALSE, 0));
-  Jumanji.UI.tabbar            = gtk_hbox_new(TRUE, 0);
-  Jumanji.UI.inputbar          = GTK_ENTRY(gtk_entry_new());
-  Jumanji.UI.view              = GTK_NOTEBOOK(gtk_notebook_new());
+  /* remove the tab from the registry before the notebook switches pages */
+  g_ptr_array_remove_index(Jumanji.Tabs.list, position);
+  g_hash_table_remove(Jumanji.Tabs.ids, GINT_TO_POINTER(tab->id));
 
-  /* window */
-  gtk_window_set_title(GTK_WINDOW(Jumanji.UI.window), "jumanji");
-  GdkGeometry hints = { 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-  gtk_window_set_geometry_hints(GTK_WINDOW(Jumanji.UI.window), NULL, &hints, GDK_HINT_MIN_SIZE);
-  g_signal_connect(G_OBJECT(Jumanji.UI.window), "destroy", G_CALLBACK(cb_destroy), NULL);
+  for(unsigned int i = position; i < Jumanji.Tabs.list->len; i++)
+    GET_TAB(i)->position = i;
 
-  /* box */
-  gtk_box_set_spacing(Jumanji.UI.box, 0);
-  gtk_container_add(GTK_CONTAINER(Jumanji.UI.window), GTK_WIDGET(Jumanji.UI.box));
+  if(Jumanji.Tabs.current == tab)
+  {
+    Jumanji.Tabs.current = NULL;
+    set_link(NULL);
+  }
 
-  /* statusbar */
-  Jumanji.Statusbar.text       = GTK_LABEL(gtk_label_new(NULL));
-  Jumanji.Statusbar.buffer     = GTK_LABEL(gtk_label_new(NULL));
-  Jumanji.Statusbar.tabs       = GTK_LABEL(gtk_label_new(NULL));
-  Jumanji.Statusbar.position   = GTK_LABEL(gtk_label_new(NULL));
+  if(tab->label_queued)
+    Jumanji.Statusbar.dirty_tabs = g_list_remove(Jumanji.Statusbar.dirty_tabs, tab);
 
-  gtk_misc_set_alignment(GTK_MISC(Jumanji.Statusbar.text),     0.0, 0.0);
-  gtk_misc_set_alignment(GTK_MISC(Jumanji.Statusbar.buffer),   1.0, 0.0);
-  gtk_misc_set_alignment(GTK_MISC(Jumanji.Statusbar.tabs),     1.0, 0.0);
-  gtk_misc_set_alignment(GTK_MISC(Jumanji.Statusbar.position), 1.0, 0.0);
+  if(Jumanji.Hints.tab == tab)
+    hints_reset();
 
-  gtk_misc_set_padding(GTK_MISC(Jumanji.Statusbar.text),     2.0, 4.0);
-  gtk_misc_set_padding(GTK_MISC(Jumanji.Statusbar.buffer),   2.0, 4.0);
-  gtk_misc_set_padding(GTK_MISC(Jumanji.Statusbar.tabs),     2.0, 4.0);
-  gtk_misc_set_padding(GTK_MISC(Jumanji.Statusbar.position), 2.0, 4.0);
+  prerender_drop(tab);
 
-  gtk_box_pack_start(Jumanji.UI.statusbar_entries, GTK_WIDGET(Jumanji.Statusbar.text),     TRUE,   TRUE, 2);
-  gtk_box_pack_start(Jumanji.UI.statusbar_entries, GTK_WIDGET(Jumanji.Statusbar.buffer),   FALSE, FALSE, 2);
-  gtk_box_pack_start(Jumanji.UI.statusbar_entries, GTK_WIDGET(Jumanji.Statusbar.tabs),     FALSE, FALSE, 2);
-  gtk_box_pack_start(Jumanji.UI.statusbar_entries, GTK_WIDGET(Jumanji.Statusbar.position), FALSE, FALSE, 2);
+  for(int i = 0; i < Jumanji.Tabs.n_slots; i++)
+    if(Jumanji.Tabs.slots[i].tab == tab)
+      Jumanji.Tabs.slots[i].tab = NULL;
 
-  gtk_container_add(GTK_CONTAINER(Jumanji.UI.statusbar), GTK_WIDGET(Jumanji.UI.statusbar_entries));
+  gtk_notebook_remove_page(Jumanji.UI.view, position);
 
-  /* inputbar */
-  gtk_entry_set_inner_border(Jumanji.UI.inputbar, NULL);
-  gtk_entry_set_has_frame(   Jumanji.UI.inputbar, FALSE);
-  gtk_editable_set_editable( GTK_EDITABLE(Jumanji.UI.inputbar), TRUE);
+  if(tab->scripts)
+    g_ptr_array_free(tab->scripts, TRUE);
 
-  g_signal_connect(G_OBJECT(Jumanji.UI.inputbar), "key-press-event", G_CALLBACK(cb_inputbar_kb_pressed), NULL);
-  g_signal_connect(GTK_EDITABLE(Jumanji.UI.inputbar), "changed",     G_CALLBACK(cb_inputbar_changed),    NULL);
-  g_signal_connect(G_OBJECT(Jumanji.UI.inputbar), "activate",        G_CALLBACK(cb_inputbar_activate),   NULL);
+  if(tab->requests)
+    g_ptr_array_free(tab->requests, TRUE);
 
-  /* view */
-  gtk_notebook_set_show_tabs(Jumanji.UI.view,   FALSE);
-  gtk_notebook_set_show_border(Jumanji.UI.view, FALSE);
+  g_free(tab->stylesheet);
+  g_free(tab->user_stylesheet);
+  g_free(tab);
+}
 
-  /* packing */
-  gtk_box_pack_start(Jumanji.UI.box, GTK_WIDGET(Jumanji.UI.tabbar),    FALSE, FALSE, 0);
-  gtk_box_pack_start(Jumanji.UI.box, GTK_WIDGET(Jumanji.UI.view),       TRUE,  TRUE, 0);
-  gtk_box_pack_start(Jumanji.UI.box, GTK_WIDGET(Jumanji.UI.statusbar), FALSE, FALSE, 0);
-  gtk_box_pack_end(  Jumanji.UI.box, GTK_WIDGET(Jumanji.UI.inputbar),  FALSE, FALSE, 0);
+void
+connect_view(WebKitWebView* wv, Tab* tab)
+{
+  /* these callbacks follow the view when a prerender is swapped in */
+  g_signal_connect(G_OBJECT(wv),  "notify::load-status",                  G_CALLBACK(cb_wv_notify_load_status),       tab);
+  g_signal_connect(G_OBJECT(wv),  "notify::progress",                     G_CALLBACK(cb_wv_notify_progress),          tab);
+  g_signal_connect(G_OBJECT(wv),  "notify::title",                        G_CALLBACK(cb_wv_notify_title),             tab);
+  g_signal_connect(G_OBJECT(wv),  "resource-request-starting",            G_CALLBACK(cb_wv_resource_request),         tab);
+  g_signal_connect(G_OBJECT(wv),  "window-object-cleared",                G_CALLBACK(cb_wv_window_object_cleared),    tab);
+}
 
-  Jumanji.Global.init_ui = TRUE;
+char*
+cookies_base_domain(const char* domain)
+{
+  if(!domain)
+    return NULL;
+
+  if(domain[0] == '.')
+    domain++;
+
+  /* addresses and local names have no public suffix */
+  const char* base = soup_tld_get_base_domain(domain, NULL);
+
+  return g_ascii_strdown(base ? base : domain, -1);
 }
 
-void notify(int level, char* message)
+GHashTable*
+cookies_collect()
 {
-  if(!Jumanji.Global.init_ui)
+  /* base domain -> its cookies in the netscape format, empty if it has none
+   * left; loaded domains are complete in the jar */
+  GHashTable* batch = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+  GHashTableIter iter;
+  gpointer domain;
+
+  g_hash_table_iter_init(&iter, Jumanji.Cookies.dirty);
+  while(g_hash_table_iter_next(&iter, &domain, NULL))
+    cookies_load(domain);
+
+  GSList* cookies = soup_cookie_jar_all_cookies(Jumanji.Cookies.jar);
+  GHashTable* contents = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+  for(GSList* l = cookies; l; l = g_slist_next(l))
   {
-    if(message)
+    SoupCookie* cookie = (SoupCookie*) l->data;
+    char* base = cookies_base_domain(cookie->domain);
+
+    /* session cookies are not kept */
+    if(cookie->expires && base && g_hash_table_lookup_extended(Jumanji.Cookies.dirty, base, NULL, NULL))
     {
-      /* print error message to stdout while the ui has not been loaded */
-      char* dmessage = g_strconcat("jumanjirc: ", message, NULL);
-      printf("%s\n", dmessage);
-      g_free(dmessage);
-    }
+      GString* content = g_hash_table_lookup(contents, base);
+      if(!content)
+      {
+        content = g_string_new(NULL);
+        g_hash_table_insert(contents, g_strdup(base), content);
+      }
 
-    return;
-  }
+      g_string_append_printf(content, "%s%s\t%s\t%s\t%s\t%lu\t%s\t%s\n", cookie->http_only ? "#HttpOnly_" : "",
+          cookie->domain, cookie->domain[0] == '.' ? "TRUE" : "FALSE", cookie->path, cookie->secure ? "TRUE" : "FALSE",
+          (unsigned long) soup_date_to_time_t(cookie->expires), cookie->name, cookie->value);
+    }
 
-  if(!message || strlen(message) <= 0)
-  {
-    gtk_widget_hide(GTK_WIDGET(Jumanji.UI.inputbar));
-    return;
+    g_free(base);
+    soup_cookie_free(cookie);
   }
 
-  if(!(GTK_WIDGET_VISIBLE(GTK_WIDGET(Jumanji.UI.inputbar))))
-    gtk_widget_show(GTK_WIDGET(Jumanji.UI.inputbar));
+  g_slist_free(cookies);
 
-  switch(level)
+  g_hash_table_iter_init(&iter, Jumanji.Cookies.dirty);
+  while(g_hash_table_iter_next(&iter, &domain, NULL))
   {
-    case ERROR:
-      gtk_widget_modify_base(GTK_WIDGET(Jumanji.UI.inputbar), GTK_STATE_NORMAL, &(Jumanji.Style.notification_e_bg));
-      gtk_widget_modify_text(GTK_WIDGET(Jumanji.UI.inputbar), GTK_STATE_NORMAL, &(Jumanji.Style.notification_e_fg));
-      break;
-    case WARNING:
-      gtk_widget_modify_base(GTK_WIDGET(Jumanji.UI.inputbar), GTK_STATE_NORMAL, &(Jumanji.Style.notification_w_bg));
-      gtk_widget_modify_text(GTK_WIDGET(Jumanji.UI.inputbar), GTK_STATE_NORMAL, &(Jumanji.Style.notification_w_fg));
-      break;
-    default:
-      gtk_widget_modify_base(GTK_WIDGET(Jumanji.UI.inputbar), GTK_STATE_NORMAL, &(Jumanji.Style.inputbar_bg));
-      gtk_widget_modify_text(GTK_WIDGET(Jumanji.UI.inputbar), GTK_STATE_NORMAL, &(Jumanji.Style.inputbar_fg));
-      break;
+    GString* content = g_hash_table_lookup(contents, domain);
+    g_hash_table_insert(batch, g_strdup(domain), content ? g_string_free(content, FALSE) : g_strdup(""));
+
+    /* the domain has a file now, which is already loaded */
+    g_hash_table_insert(Jumanji.Cookies.domains, g_strdup(domain), GINT_TO_POINTER(TRUE));
   }
 
-  if(message)
-    gtk_entry_set_text(Jumanji.UI.inputbar, message);
+  g_hash_table_destroy(contents);
+  g_hash_table_remove_all(Jumanji.Cookies.dirty);
+
+  return batch;
 }
 
 void
-init_jumanji()
+cookies_import(const char* file, const char* store)
 {
-  /* other */
-  Jumanji.Global.mode                = NORMAL;
-  Jumanji.Global.search_engines      = NULL;
-  Jumanji.Global.command_history     = NULL;
-  Jumanji.Global.scripts             = NULL;
-  Jumanji.Global.markers             = NULL;
-  Jumanji.Global.bookmarks           = NULL;
-  Jumanji.Global.history             = NULL;
-  Jumanji.Global.last_closed         = NULL;
-  Jumanji.Global.init_ui             = FALSE;
-  Jumanji.Bindings.sclist            = NULL;
-  Jumanji.Bindings.bcmdlist          = NULL;
+  char* content = NULL;
 
-  /* webkit settings */
-  Jumanji.Global.browser_settings = webkit_web_settings_new();
+  if(!g_file_get_contents(file, &content, NULL, NULL))
+    return;
 
-  /* GDK keymap */
-  Jumanji.Global.keymap = gdk_keymap_get_default();
+  /* group the lines by the base domain of their first field */
+  GHashTable* domains = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  gchar**     lines   = g_strsplit(content, "\n", -1);
 
-  /* libsoup session */
-  Jumanji.Soup.session = webkit_get_default_session();
-}
+  for(int i = 0; lines[i]; i++)
+  {
+    const char* line = lines[i];
 
-void
-new_window(char* uri)
-{
-  if(!uri)
-    return;
+    if(g_str_has_prefix(line, "#HttpOnly_"))
+      line += strlen("#HttpOnly_");
+    else if(line[0] == '#' || !line[0])
+      continue;
 
-  char* nargv[6];
-  if(Jumanji.UI.embed)
-  {
-    nargv[0] = *(Jumanji.Global.arguments);
-    nargv[1] = "-e";
-    nargv[2] = Jumanji.UI.winid;
-    nargv[3] = uri;
-    nargv[4] = NULL;
+    char* domain = g_strndup(line, strcspn(line, "\t"));
+    char* base   = cookies_base_domain(domain);
+
+    if(!*base)
+    {
+      g_free(base);
+      g_free(domain);
+      continue;
+    }
+
+    GString* cookies = g_hash_table_lookup(domains, base);
+    if(!cookies)
+    {
+      cookies = g_string_new(NULL);
+      g_hash_table_insert(domains, g_strdup(base), cookies);
+    }
+
+    g_string_append_printf(cookies, "%s\n", lines[i]);
+
+    g_free(base);
+    g_free(domain);
   }
-  else
+
+  GHashTableIter iter;
+  gpointer domain, cookies;
+
+  g_hash_table_iter_init(&iter, domains);
+  while(g_hash_table_iter_next(&iter, &domain, &cookies))
   {
-    nargv[0] = *(Jumanji.Global.arguments);
-    nargv[1] = uri;
-    nargv[2] = NULL;
+    char* path = g_build_filename(store, domain, NULL);
+    g_file_set_contents(path, ((GString*) cookies)->str, -1, NULL);
+    g_string_free((GString*) cookies, TRUE);
+    g_free(path);
   }
 
-  g_spawn_async(NULL, nargv, NULL, G_SPAWN_SEARCH_PATH, NULL, NULL, NULL, NULL);
+  g_hash_table_destroy(domains);
+  g_strfreev(lines);
+  g_free(content);
 }
 
 void
-out_of_memory()
+cookies_load(const char* host)
 {
-  printf("error: out of memory\n");
-  exit(-1);
-}
+  char* base = cookies_base_domain(host);
+  gpointer loaded;
 
-void
-open_uri(WebKitWebView* web_view, char* uri)
-{
-  if(!uri)
+  /* only domains with a file that has not been read yet */
+  if(!base || !g_hash_table_lookup_extended(Jumanji.Cookies.domains, base, NULL, &loaded) || loaded)
+  {
+    g_free(base);
     return;
+  }
 
-  while (*uri == ' ')
-    uri++;
+  g_hash_table_insert(Jumanji.Cookies.domains, g_strdup(base), GINT_TO_POINTER(TRUE));
 
-  gchar* new_uri = NULL;
+  char* path    = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_COOKIE_STORE, base, NULL);
+  char* content = NULL;
 
-  /* multiple argument given */
-  char* uri_first_space = strchr(uri, ' ');
-  if(uri_first_space)
+  if(g_file_get_contents(path, &content, NULL, NULL))
   {
-    unsigned int first_arg_length = uri_first_space - uri;
+    gchar** lines = g_strsplit(content, "\n", -1);
+    gint64  now   = g_get_real_time() / G_USEC_PER_SEC;
 
-    SearchEngineList* se = Jumanji.Global.search_engines;
-    while(se)
-    {
-      if(strlen(se->name) == first_arg_length && !strncmp(uri, se->name, first_arg_length))
-        break;
+    Jumanji.Cookies.loading = TRUE;
 
-      se = se->next;
-    }
-    /* first agrument contain "://"
-     * -> it's a bookmark with tag
-     */
-    if(!se && strstr(uri, "://"))
-    {
-      new_uri = g_strndup(uri, first_arg_length);
-    }
-    /* first agrument doesn't contain "://"
-     * -> use search engine
-     */
-    else
+    for(int i = 0; lines[i]; i++)
     {
-      if(!se)
-        se = Jumanji.Global.search_engines;
-      else /* we remove the trailing arg since it's the se name */
-        uri = uri + first_arg_length + 1;
-
-      if(se)
-      {
-        /* there is at lease 1 search search engine */
-        new_uri = g_strdup_printf(se->uri, uri);
-
-        /* we change all the space with '+'
-         * -2 for the '%s'
-         */
-        char* new_uri_it = new_uri + strlen(se->uri) - 2;
-
-        while(*new_uri_it)
-        {
-          if(*new_uri_it == ' ')
-            *new_uri_it = '+';
+      gboolean http_only = g_str_has_prefix(lines[i], "#HttpOnly_");
+      gchar**  fields    = g_strsplit(lines[i] + (http_only ? strlen("#HttpOnly_") : 0), "\t", 7);
 
-          new_uri_it++;
-        }
-      }
-      else
+      if(g_strv_length(fields) == 7 && fields[0][0] != '#' && (gint64) strtoul(fields[4], NULL, 10) > now)
       {
-        /* there is 0 search engine (a very rare case...) */
-        new_uri = g_strconcat("http://", uri, NULL);
-
-        char* nu_first_space;
-
-        /* we fill ' ' with '%20' */
-        while ((nu_first_space = strchr(new_uri, ' ')))
-        {
-          /* we break new_uri at the first ' ' */
-          *nu_first_space = '\0';
-          char* nu_first_part = new_uri;
-          char* nu_second_part = nu_first_space + 1;
-
-          new_uri = g_strconcat(nu_first_part, "%20", nu_second_part, NULL);
-
-          g_free(nu_first_part);
-        }
+        SoupCookie* cookie  = soup_cookie_new(fields[5], fields[6], fields[0], fields[2], -1);
+        SoupDate*   expires = soup_date_new_from_time_t(strtoul(fields[4], NULL, 10));
+
+        soup_cookie_set_expires(cookie, expires);
+        soup_cookie_set_secure(cookie, !strcmp(fields[3], "TRUE"));
+        soup_cookie_set_http_only(cookie, http_only);
+        soup_cookie_jar_add_cookie(Jumanji.Cookies.jar, cookie);
+        soup_date_free(expires);
       }
-    }
-  }
-  /* no argument given */
-  else if(strlen(uri) == 0)
-  {
-    new_uri = g_strdup(home_page);
-  }
-  /* only one argument given */
-  else
-  {
-    /* uri reformating to get new_uri match
-     * ^http://.*$
-     * or
-     * ^file://.*$
-     */
 
-    /* file path */
-    if(uri[0] == '/' || strncmp(uri, "./", 2) == 0)
-    {
-      new_uri = g_strconcat("file://", uri, NULL);
+      g_strfreev(fields);
     }
-    /* uri does contain any ".", ":" or "/"
-     * nor it start with "localhost"
-     * -> default searchengine
-     */
-    else if(!strpbrk(uri, ".:/") && strncmp(uri, "localhost", 9))
-    {
-      if(Jumanji.Global.search_engines)
-      {
-        new_uri = g_strdup_printf(Jumanji.Global.search_engines->uri, uri);
-
-        /* -2 for the '%s' */
-        gchar* searchitem = new_uri + strlen(Jumanji.Global.search_engines->uri) - 2;
 
-        while(*searchitem)
-        {
-          if(*searchitem == ' ')
-            *searchitem = '+';
+    Jumanji.Cookies.loading = FALSE;
 
-          searchitem += 1;
-        }
-      }
-      else
-        new_uri = g_strconcat("http://", uri, NULL);
-    }
-    else
-      new_uri = strstr(uri, "://") ? g_strdup(uri) : g_strconcat("http://", uri, NULL);
+    g_strfreev(lines);
+    g_free(content);
   }
 
-  webkit_web_view_load_uri(web_view, new_uri);
+  g_free(path);
+  g_free(base);
+}
 
-  /* update history */
-  if(!private_browsing)
-  {
-    /* we verify if the new_uri is already present in the list*/
-    GList* l = g_list_find_custom(Jumanji.Global.history, new_uri, (GCompareFunc)strcmp);
-    if (l)
-    {
-      /* new_uri is already present : new move it to the end of the list */
-      Jumanji.Global.history = g_list_remove_link(Jumanji.Global.history, l);
-      Jumanji.Global.history = g_list_concat(l, Jumanji.Global.history);
-    }
-    else
-    {
-      Jumanji.Global.history = g_list_prepend(Jumanji.Global.history, g_strdup(new_uri));
-    }
-  }
+gpointer
+cookies_thread(gpointer data)
+{
+  cookies_write((GHashTable*) data);
 
-  g_free(new_uri);
+  /* the thread is joined in the main loop */
+  g_idle_add(cb_cookies_flushed, NULL);
 
-  update_status();
+  return NULL;
 }
 
 void
-update_status()
+cookies_write(GHashTable* batch)
 {
-  if(!Jumanji.UI.view || !gtk_notebook_get_n_pages(Jumanji.UI.view))
-    return;
+  char* store = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_COOKIE_STORE, NULL);
+  GHashTableIter iter;
+  gpointer domain, content;
 
-  update_uri();
+  g_hash_table_iter_init(&iter, batch);
+  while(g_hash_table_iter_next(&iter, &domain, &content))
+  {
+    char* path = g_build_filename(store, domain, NULL);
 
-  /* update title */
-  const gchar* title = webkit_web_view_get_title(GET_CURRENT_TAB());
-  if(title)
-    gtk_window_set_title(GTK_WINDOW(Jumanji.UI.window), title);
-  else
-    gtk_window_set_title(GTK_WINDOW(Jumanji.UI.window), "jumanji");
+    if(*((char*) content))
+      g_file_set_contents(path, content, -1, NULL);
+    else
+      unlink(path);
 
-  /* update tab position */
-  int current_tab     = gtk_notebook_get_current_page(Jumanji.UI.view);
-  int number_of_tabs  = gtk_notebook_get_n_pages(Jumanji.UI.view);
+    g_free(path);
+  }
+
+  g_hash_table_destroy(batch);
 
-  gchar* tabs = g_strdup_printf("[%d/%d]", current_tab + 1, number_of_tabs);
-  gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.tabs, tabs);
-  g_free(tabs);
+  /* tools like wget read all cookies from the netscape cookie file */
+  GString* export = g_string_new("# Netscape HTTP Cookie File\n");
+  GDir*    dir    = g_dir_open(store, 0, NULL);
 
-  /* update tabbar */
-  int tc = 0;
-  for(tc = 0; tc < number_of_tabs; tc++)
+  for(const char* name; dir && (name = g_dir_read_name(dir));)
   {
-    GtkWidget* tab       = GTK_WIDGET(GET_NTH_TAB_WIDGET(tc));
-    GtkWidget *tev_box   = GTK_WIDGET(g_object_get_data(G_OBJECT(tab), "tab"));
-    GtkWidget *tab_label = GTK_WIDGET(g_object_get_data(G_OBJECT(tab), "label"));
+    char* path = g_build_filename(store, name, NULL);
+    char* cookies = NULL;
 
-    if(tc == current_tab)
-    {
-      gtk_widget_modify_bg(GTK_WIDGET(tev_box),   GTK_STATE_NORMAL, &(Jumanji.Style.tabbar_focus_bg));
-      gtk_widget_modify_fg(GTK_WIDGET(tab_label), GTK_STATE_NORMAL, &(Jumanji.Style.tabbar_focus_fg));
-    }
-    else
-    {
-      gtk_widget_modify_bg(GTK_WIDGET(tev_box),   GTK_STATE_NORMAL, &(Jumanji.Style.tabbar_bg));
-      gtk_widget_modify_fg(GTK_WIDGET(tab_label), GTK_STATE_NORMAL, &(Jumanji.Style.tabbar_fg));
-    }
+    if(g_file_get_contents(path, &cookies, NULL, NULL))
+      g_string_append(export, cookies);
 
-    const gchar* tab_title = webkit_web_view_get_title(GET_WEBVIEW(tab));
-    int progress = webkit_web_view_get_progress(GET_WEBVIEW(tab)) * 100;
-    gchar* n_tab_title = g_strdup_printf("%d | %s", tc + 1, tab_title ? tab_title : ((progress == 100) ? "Loading..." : "(Untitled)"));
-    gtk_label_set_text((GtkLabel*) tab_label, n_tab_title);
-    g_free(n_tab_title);
+    g_free(cookies);
+    g_free(path);
   }
 
-  update_position();
+  if(dir)
+    g_dir_close(dir);
+
+  char* file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_COOKIES, NULL);
+  g_file_set_contents(file, export->str, -1, NULL);
+
+  g_free(file);
+  g_free(store);
+  g_string_free(export, TRUE);
 }
 
-void
-update_uri()
+GtkWidget*
+create_tab(char* uri, gboolean background)
 {
-  gchar* link  = (gchar*) webkit_web_view_get_uri(GET_CURRENT_TAB());
-  int progress = webkit_web_view_get_progress(GET_CURRENT_TAB()) * 100;
-  gchar* uri   = (progress != 100 && progress != 0) ? g_strdup_printf("Loading... %s (%d%%)", link ? link : "", progress) :
-                 (link ? g_strdup(link) : NULL);
+  if(!uri)
+    return NULL;
 
-  /* check for https */
-  GdkColor* fg;
-  GdkColor* bg;
+  GtkWidget *tab = gtk_scrolled_window_new(NULL, NULL);
 
-  gboolean ssl = link ? g_str_has_prefix(link, "https://") : FALSE;
-  if(ssl)
-  {
-    fg = &(Jumanji.Style.statusbar_ssl_fg);
-    bg = &(Jumanji.Style.statusbar_ssl_bg);
-  }
-  else
-  {
-    fg = &(Jumanji.Style.statusbar_fg);
-    bg = &(Jumanji.Style.statusbar_bg);
-  }
+  if(!tab)
+    return NULL;
 
-  gtk_widget_modify_bg(GTK_WIDGET(Jumanji.UI.statusbar),      GTK_STATE_NORMAL,  bg);
-  gtk_widget_modify_fg(GTK_WIDGET(Jumanji.Statusbar.text),     GTK_STATE_NORMAL, fg);
-  gtk_widget_modify_fg(GTK_WIDGET(Jumanji.Statusbar.buffer),   GTK_STATE_NORMAL, fg);
-  gtk_widget_modify_fg(GTK_WIDGET(Jumanji.Statusbar.tabs),     GTK_STATE_NORMAL, fg);
-  gtk_widget_modify_fg(GTK_WIDGET(Jumanji.Statusbar.position), GTK_STATE_NORMAL, fg);
+  int number_of_tabs = Jumanji.Tabs.list->len;
+  int position       = (next_to_current && Jumanji.Tabs.current) ? (Jumanji.Tabs.current->position + 1) : number_of_tabs;
 
+  /* register tab */
+  Tab* t = g_malloc0(sizeof(Tab));
+  t->id       = Jumanji.Tabs.next_id++;
+  t->position = position;
+  t->widget   = tab;
+  t->view     = create_view(t);
 
-  /* check for possible navigation */
-  if(!uri)
-    uri = g_strdup("[No name]");
-  else
+  GtkWidget* wv = GTK_WIDGET(t->view);
+
+  g_ptr_array_add(Jumanji.Tabs.list, NULL);
+  for(int i = number_of_tabs; i > position; i--)
   {
-    GString* navigation = g_string_new("");
+    Jumanji.Tabs.list->pdata[i] = Jumanji.Tabs.list->pdata[i - 1];
+    GET_TAB(i)->position = i;
+  }
 
-    if(webkit_web_view_can_go_back(GET_CURRENT_TAB()))
-      g_string_append_c(navigation, '+');
-    if(webkit_web_view_can_go_forward(GET_CURRENT_TAB()))
-      g_string_append_c(navigation, '-');
+  Jumanji.Tabs.list->pdata[position] = t;
+  g_hash_table_insert(Jumanji.Tabs.ids, GINT_TO_POINTER(t->id), t);
+  g_object_set_data(G_OBJECT(tab), "tab", t);
 
-    if(navigation->len > 0)
-    {
-      char* new_uri = g_strconcat(uri, " [", navigation->str, "]", NULL);
-      g_free(uri);
-      uri = new_uri;
-    }
+  if(show_scrollbars)
+    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(tab), GTK_POLICY_AUTOMATIC, GTK_POLICY_AUTOMATIC);
+  else
+    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(tab), GTK_POLICY_NEVER, GTK_POLICY_NEVER);
 
-    g_string_free(navigation, TRUE);
-  }
+  GtkAdjustment* adjustment = gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(tab));
 
-  gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.text, uri);
-  g_free(uri);
-}
+  /* connect tab callbacks */
+  g_signal_connect(G_OBJECT(tab),        "key-press-event", G_CALLBACK(cb_tab_kb_pressed), NULL);
+  g_signal_connect(G_OBJECT(adjustment), "value-changed",   G_CALLBACK(cb_wv_scrolled),    NULL);
 
-void
-update_position()
-{
-  if (gtk_notebook_get_current_page(Jumanji.UI.view) == -1)
-    return;
+  gtk_container_add(GTK_CONTAINER(tab), wv);
+  gtk_widget_show_all(tab);
+  gtk_notebook_insert_page(Jumanji.UI.view, tab, NULL, position);
 
-  GtkAdjustment* adjustment = gtk_scrolled_window_get_vadjustment(GET_CURRENT_TAB_WIDGET());
-  gdouble view_size         = gtk_adjustment_get_page_size(adjustment);
-  gdouble value             = gtk_adjustment_get_value(adjustment);
-  gdouble max               = gtk_adjustment_get_upper(adjustment) - view_size;
+  if(!background)
+    gtk_notebook_set_current_page(Jumanji.UI.view, position);
 
-  gchar* position;
-  if(max == 0)
-    position = g_strdup("All");
-  else if(value == max)
-    position = g_strdup("Bot");
-  else if(value == 0)
-    position = g_strdup("Top");
-  else
-    position = g_strdup_printf("%2d%%", (int) ceil(((value / max) * 100)));
+  gtk_widget_grab_focus(GTK_WIDGET(GET_CURRENT_TAB_WIDGET()));
 
-  gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.position, position);
-  g_free(position);
+  /* open uri */
+  open_uri(WEBKIT_WEB_VIEW(wv), uri);
+
+  return wv;
 }
 
-void
-read_configuration()
+WebKitWebView*
+create_view(Tab* tab)
 {
-  char* jumanjirc = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_RC, NULL);
+  GtkWidget* wv = webkit_web_view_new();
 
-  if(!jumanjirc)
+  if(!show_scrollbars)
+  {
+    WebKitWebFrame* mf = webkit_web_view_get_main_frame(WEBKIT_WEB_VIEW(wv));
+    g_signal_connect(G_OBJECT(mf),  "scrollbars-policy-changed", G_CALLBACK(cb_blank), NULL);
+  }
+
+  /* connect webview callbacks */
+  g_signal_connect(G_OBJECT(wv),  "console-message",                      G_CALLBACK(cb_blank),                       NULL);
+  g_signal_connect(G_OBJECT(wv),  "create-web-view",                      G_CALLBACK(cb_wv_create_web_view),          NULL);
+  g_signal_connect(G_OBJECT(wv),  "download-requested",                   G_CALLBACK(cb_wv_download_request),         NULL);
+  g_signal_connect(G_OBJECT(wv),  "button-release-event",                 G_CALLBACK(cb_wv_button_release_event),     NULL);
+  g_signal_connect(G_OBJECT(wv),  "hovering-over-link",                   G_CALLBACK(cb_wv_hover_link),               NULL);
+  g_signal_connect(G_OBJECT(wv),  "key-press-event",                      G_CALLBACK(cb_wv_kb_pressed),               NULL);
+  g_signal_connect(G_OBJECT(wv),  "mime-type-policy-decision-requested",  G_CALLBACK(cb_wv_mimetype_policy_decision), NULL);
+  g_signal_connect(G_OBJECT(wv),  "navigation-policy-decision-requested", G_CALLBACK(cb_wv_nav_policy_decision),      NULL);
+  g_signal_connect(G_OBJECT(wv),  "new-window-policy-decision-requested", G_CALLBACK(cb_wv_window_policy_decision),   NULL);
+  connect_view(WEBKIT_WEB_VIEW(wv), tab);
+
+  /* set default values */
+  g_object_set(G_OBJECT(wv), "full-content-zoom", full_content_zoom, NULL);
+
+  /* apply browser setting, a prerender keeps the ones of its tab */
+  WebKitWebSettings* browser_settings = Jumanji.Global.browser_settings;
+  if(tab->owner)
+    browser_settings = webkit_web_view_get_settings(tab->owner->view);
+
+  webkit_web_view_set_settings(WEBKIT_WEB_VIEW(wv), webkit_web_settings_copy(browser_settings));
+
+  /* set web inspector */
+  WebKitWebInspector* web_inspector = webkit_web_view_get_inspector(WEBKIT_WEB_VIEW(wv));
+  g_signal_connect(G_OBJECT(web_inspector), "inspect-web-view", G_CALLBACK(cb_wv_inspector_view), NULL);
+
+  return WEBKIT_WEB_VIEW(wv);
+}
+
+
+void
+eval_marker(int id)
+{
+  if((id < 0x30) || (id > 0x7A))
     return;
 
-  if(g_file_test(jumanjirc, G_FILE_TEST_IS_REGULAR))
+  GList* list;
+  for(list = Jumanji.Global.markers; list; list = g_list_next(list))
   {
-    char* content = NULL;
+    Marker* marker = (Marker*) list->data;
 
-    if(g_file_get_contents(jumanjirc, &content, NULL, NULL))
+    if(marker->id == id)
     {
-      gchar **lines = g_strsplit(content, "\n", -1);
-      int     n     = g_strv_length(lines) - 1;
+      Tab* tab = g_hash_table_lookup(Jumanji.Tabs.ids, GINT_TO_POINTER(marker->tab_id));
 
-      int i;
-      for(i = 0; i <= n; i++)
+      /* the tab has been closed */
+      if(!tab)
       {
-        if(!strlen(lines[i]))
-          continue;
+        Jumanji.Global.markers = g_list_delete_link(Jumanji.Global.markers, list);
+        free(marker);
+        return;
+      }
 
-        gchar **pre_tokens = g_strsplit_set(lines[i], "\t ", -1);
-        int     pre_length = g_strv_length(pre_tokens);
+      gtk_notebook_set_current_page(Jumanji.UI.view, tab->position);
+      GtkAdjustment* adjustment;
+      adjustment = gtk_scrolled_window_get_vadjustment(GET_CURRENT_TAB_WIDGET());
+      gtk_adjustment_set_value(adjustment, marker->vadjustment);
+      adjustment = gtk_scrolled_window_get_hadjustment(GET_CURRENT_TAB_WIDGET());
+      gtk_adjustment_set_value(adjustment, marker->hadjustment);
+      webkit_web_view_set_zoom_level(GET_CURRENT_TAB(), marker->zoom_level);
+      update_status();
+      return;
+    }
+  }
+}
 
-        gchar** tokens = g_malloc0(sizeof(gchar*) * (pre_length + 1));
-        gchar** tokp =   tokens;
-        int     length = 0;
-        for (int i = 0; i != pre_length; ++i) {
-          if (strlen(pre_tokens[i])) {
-            *tokp++ = pre_tokens[i];
-            ++length;
-          }
-        }
+JSValueRef
+evaluate_script(JSContextRef context, JSStringRef script, const char* name, const char* caller, JSValueRef* exception)
+{
+  JSValueRef error  = NULL;
+  gint64     start  = g_get_monotonic_time();
+  JSValueRef result = JSEvaluateScript(context, script, JSContextGetGlobalObject(context), NULL, 0, &error);
 
-        if(!strcmp(tokens[0], "set"))
-          cmd_set(length - 1, tokens + 1);
-        else if(!strcmp(tokens[0], "map"))
-          cmd_map(length - 1, tokens + 1);
-        else if(!strcmp(tokens[0], "bmap"))
-          cmd_bmap(length - 1, tokens + 1);
-        else if(!strcmp(tokens[0], "searchengine"))
-          cmd_search_engine(length - 1, tokens + 1);
-        else if(!strcmp(tokens[0], "script"))
-          cmd_script(length - 1, tokens + 1);
+  profile_script(name, caller, start, error != NULL);
 
-        g_free(tokens);
-      }
-    }
-  }
+  if(exception)
+    *exception = error;
 
-  g_free(jumanjirc);
+  return result;
 }
 
-char*
-read_file(const char* path)
+JSStringRef
+get_script_source(ScriptList* script)
 {
-  char* content = NULL;
-
-  /* specify path max */
-  size_t pm;
-#ifdef PATH_MAX
-  pm = PATH_MAX;
-#else
-  pm = pathconf(path,_PC_PATH_MAX);
-  if(pm <= 0)
-    pm = 4096;
-#endif
+  /* the source is only converted again after the script has changed */
+  if(!script->source)
+    script->source = JSStringCreateWithUTF8CString(script->content);
 
-  /* get filename */
-  char* npath;
+  return script->source;
+}
 
-  if(path[0] == '~')
-    npath = g_build_filename(g_get_home_dir(), path + 1, NULL);
-  else
-    npath = g_strdup(path);
+const char*
+get_hiding_stylesheet(const char* base, const char* host)
+{
+  /* the rules of the host, its parent domains and the ones for all domains */
+  GPtrArray* matched = g_ptr_array_new();
+  GString* key       = g_string_new(base);
+  const char* domain = host;
 
-  char* file = (char*) calloc(sizeof(char), pm);
-  if(!file || !realpath(npath, file))
+  while(domain)
   {
-    if(file)
-      free(file);
-    g_free(npath);
-    return NULL;
-  }
+    GPtrArray* selectors = g_hash_table_lookup(Jumanji.Hiding.rules, domain);
 
-  g_free(npath);
+    if(selectors)
+    {
+      g_ptr_array_add(matched, selectors);
+      g_string_append_printf(key, "\n%s", domain);
+    }
 
-  /* check if file exists */
-  if(g_file_test(file, G_FILE_TEST_IS_REGULAR))
-    if(g_file_get_contents(file, &content, NULL, NULL))
-      return content;
+    if(!*domain)
+      break;
 
-  return NULL;
-}
+    domain = strchr(domain, '.');
+    domain = domain ? domain + 1 : "";
+  }
 
-char*
-reference_to_string(JSContextRef context, JSValueRef reference)
-{
-  if(!context || !reference)
-    return NULL;
+  /* hosts that match the same domains share one sheet */
+  const char* sheet = NULL;
 
-  JSStringRef ref_st = JSValueToStringCopy(context, reference, NULL);
-  size_t      length = JSStringGetMaximumUTF8CStringSize(ref_st);
-  gchar*      string = g_new(gchar, length);
-  JSStringGetUTF8CString(ref_st, string, length);
-  JSStringRelease(ref_st);
+  if(matched->len)
+    sheet = g_hash_table_lookup(Jumanji.Hiding.sheets, key->str);
 
-  return string;
-}
+  if(matched->len && !sheet)
+  {
+    GString* css = g_string_new(NULL);
 
-void
-run_script(char* script, char** value, char** error)
-{
-  if(!script)
-    return;
+    if(base)
+      g_string_append_printf(css, "@import url(\"%s\");\n", base);
 
-  WebKitWebFrame *frame = webkit_web_view_get_main_frame(GET_CURRENT_TAB());
+    /* one rule per selector, an invalid selector only drops its own rule */
+    for(unsigned int i = 0; i < matched->len; i++)
+    {
+      GPtrArray* selectors = g_ptr_array_index(matched, i);
 
-  if(!frame)
-    return;
+      for(unsigned int j = 0; j < selectors->len; j++)
+        g_string_append_printf(css, "%s { display: none !important; }\n", (char*) g_ptr_array_index(selectors, j));
+    }
 
-  JSContextRef context  = webkit_web_frame_get_global_context(frame);
-  JSStringRef sc        = JSStringCreateWithUTF8CString(script);
+    char* data = g_base64_encode((guchar*) css->str, css->len);
+    char* uri  = g_strconcat("data:text/css;charset=utf-8;base64,", data, NULL);
+    g_free(data);
+    g_string_free(css, TRUE);
 
-  if(!context || !sc)
-    return;
+    g_hash_table_insert(Jumanji.Hiding.sheets, g_strdup(key->str), uri);
+    sheet = uri;
+  }
 
-  JSObjectRef ob = JSContextGetGlobalObject(context);
+  g_ptr_array_free(matched, TRUE);
+  g_string_free(key, TRUE);
 
-  if(!ob)
-    return;
+  return sheet;
+}
 
-  JSValueRef exception = NULL;
-  JSValueRef va   = JSEvaluateScript(context, sc, ob, NULL, 0, &exception);
-  JSStringRelease(sc);
+void
+invalidate_script_source(ScriptList* script)
+{
+  if(script->source)
+    JSStringRelease(script->source);
 
-  if(!va && error)
-    *error = reference_to_string(context, exception);
-  else if(value)
-    *value = reference_to_string(context, va);
+  script->source = NULL;
 }
 
 void
-set_completion_row_color(GtkBox* results, int mode, int id)
+compile_script_patterns(ScriptList* script)
 {
-  GtkEventBox *row   = (GtkEventBox*) g_list_nth_data(gtk_container_get_children(GTK_CONTAINER(results)), id);
+  g_slist_free_full(script->include, (GDestroyNotify) g_pattern_spec_free);
+  g_slist_free_full(script->exclude, (GDestroyNotify) g_pattern_spec_free);
+  script->include = NULL;
+  script->exclude = NULL;
 
-  if(row)
+  /* patterns of the configuration, excluding patterns start with a '!' */
+  for(char** pattern = script->patterns; pattern && *pattern; pattern++)
   {
-    GtkBox      *col   = (GtkBox*)      g_list_nth_data(gtk_container_get_children(GTK_CONTAINER(row)), 0);
-    GtkLabel    *cmd   = (GtkLabel*)    g_list_nth_data(gtk_container_get_children(GTK_CONTAINER(col)), 0);
-    GtkLabel    *cdesc = (GtkLabel*)    g_list_nth_data(gtk_container_get_children(GTK_CONTAINER(col)), 1);
-
-    if(mode == NORMAL)
-    {
-      gtk_widget_modify_fg(GTK_WIDGET(cmd),   GTK_STATE_NORMAL, &(Jumanji.Style.completion_fg));
-      gtk_widget_modify_fg(GTK_WIDGET(cdesc), GTK_STATE_NORMAL, &(Jumanji.Style.completion_fg));
-      gtk_widget_modify_bg(GTK_WIDGET(row),   GTK_STATE_NORMAL, &(Jumanji.Style.completion_bg));
-    }
+    if((*pattern)[0] == '!')
+      script->exclude = g_slist_prepend(script->exclude, g_pattern_spec_new(*pattern + 1));
     else
-    {
-      gtk_widget_modify_fg(GTK_WIDGET(cmd),   GTK_STATE_NORMAL, &(Jumanji.Style.completion_hl_fg));
-      gtk_widget_modify_fg(GTK_WIDGET(cdesc), GTK_STATE_NORMAL, &(Jumanji.Style.completion_hl_fg));
-      gtk_widget_modify_bg(GTK_WIDGET(row),   GTK_STATE_NORMAL, &(Jumanji.Style.completion_hl_bg));
-    }
+      script->include = g_slist_prepend(script->include, g_pattern_spec_new(*pattern));
+  }
+
+  /* greasemonkey metadata */
+  gchar** lines    = g_strsplit(script->content, "\n", -1);
+  gboolean in_meta = FALSE;
+
+  for(gchar** line = lines; *line; line++)
+  {
+    char* l = g_strstrip(*line);
+
+    if(!strncmp(l, "//", 2))
+      l = g_strchug(l + 2);
+    else if(*l)
+      break;
+
+    if(!strcmp(l, "==UserScript=="))
+      in_meta = TRUE;
+    else if(!strcmp(l, "==/UserScript=="))
+      break;
+    else if(in_meta && !strncmp(l, "@include", 8) && g_ascii_isspace(l[8]))
+      script->include = g_slist_prepend(script->include, g_pattern_spec_new(g_strchug(l + 9)));
+    else if(in_meta && !strncmp(l, "@exclude", 8) && g_ascii_isspace(l[8]))
+      script->exclude = g_slist_prepend(script->exclude, g_pattern_spec_new(g_strchug(l + 9)));
   }
+
+  g_strfreev(lines);
+
+  /* the scripts of open pages are matched again on their next frame */
+  Jumanji.Global.script_generation++;
 }
 
 void
-switch_view(GtkWidget* UNUSED(widget))
+match_scripts(Tab* tab, const char* uri)
 {
-  /*GtkWidget* child = gtk_bin_get_child(GTK_BIN(Jumanji.UI.viewport));*/
-  /*if(child)*/
-  /*{*/
-    /*g_object_ref(child);*/
-    /*gtk_container_remove(GTK_CONTAINER(Jumanji.UI.viewport), child);*/
-  /*}*/
+  if(tab->scripts)
+    g_ptr_array_set_size(tab->scripts, 0);
+  else
+    tab->scripts = g_ptr_array_new();
 
-  /*gtk_container_add(GTK_CONTAINER(Jumanji.UI.viewport), GTK_WIDGET(widget));*/
+  tab->script_generation = Jumanji.Global.script_generation;
+
+  for(ScriptList* sl = Jumanji.Global.scripts; sl; sl = sl->next)
+  {
+    gboolean match = !sl->include;
+
+    for(GSList* l = sl->include; l && !match && uri; l = g_slist_next(l))
+      match = g_pattern_match_string((GPatternSpec*) l->data, uri);
+
+    for(GSList* l = sl->exclude; l && match && uri; l = g_slist_next(l))
+      match = !g_pattern_match_string((GPatternSpec*) l->data, uri);
+
+    if(match)
+      g_ptr_array_add(tab->scripts, sl);
+  }
 }
 
-GtkEventBox*
-create_completion_row(GtkBox* results, char* command, char* description, gboolean group)
+static const char prerender_probe[] =
+  "(function() {"
+  "  var l = document.querySelector('link[rel~=next][href], a[rel~=next][href]');"
+  "  var a = l ? [] : document.querySelectorAll('a[href]');"
+  "  for(var i = 0; i < a.length && !l; i++)"
+  "    if(/^\\s*(next( page)?|older|\\u203a|\\u00bb|>)\\s*$/i.test(a[i].textContent)) l = a[i];"
+  "  return (l && l.protocol == location.protocol && l.host == location.host) ? l.href : '';"
+  "})()";
+
+void
+prerender_drop(Tab* tab)
 {
-  GtkBox      *col = GTK_BOX(gtk_hbox_new(FALSE, 0));
-  GtkEventBox *row = GTK_EVENT_BOX(gtk_event_box_new());
+  Tab* prerender = tab->prerender;
 
-  GtkLabel *show_command     = GTK_LABEL(gtk_label_new(NULL));
-  GtkLabel *show_description = GTK_LABEL(gtk_label_new(NULL));
+  if(!prerender)
+    return;
 
-  gtk_misc_set_alignment(GTK_MISC(show_command),     0.0, 0.0);
-  gtk_misc_set_alignment(GTK_MISC(show_description), 0.0, 0.0);
+  tab->prerender = NULL;
+  g_free(tab->prerender_uri);
+  tab->prerender_uri = NULL;
 
-  /*if(group)*/
-  /*{*/
-    /*gtk_misc_set_padding(GTK_MISC(show_command),     2.0, 4.0);*/
-    /*gtk_misc_set_padding(GTK_MISC(show_description), 2.0, 4.0);*/
-  /*}*/
-  /*else*/
-  /*{*/
-    gtk_misc_set_padding(GTK_MISC(show_command),     1.0, 1.0);
-    gtk_misc_set_padding(GTK_MISC(show_description), 1.0, 1.0);
-  /*}*/
+  cb_prerender_free(prerender);
+}
 
-  gtk_label_set_use_markup(show_command,     TRUE);
-  gtk_label_set_use_markup(show_description, TRUE);
+void
+prerender_start(Tab* tab)
+{
+  if(!prerender || tab->owner || offline || tab->offline)
+    return;
 
-  gtk_label_set_markup(show_command,     g_markup_printf_escaped(FORMAT_COMMAND,     command ? command : ""));
-  gtk_label_set_markup(show_description, g_markup_printf_escaped(FORMAT_DESCRIPTION, description ? description : ""));
+  /* look for the link to the next page */
+  JSContextRef context = webkit_web_frame_get_global_context(webkit_web_view_get_main_frame(tab->view));
+  JSStringRef  probe   = JSStringCreateWithUTF8CString(prerender_probe);
+  char*        uri     = reference_to_string(context, evaluate_script(context, probe, "prerender probe", "prerender", NULL));
+  JSStringRelease(probe);
 
-  if(group)
+  if(!uri || !*uri || (tab->prerender_uri && !strcmp(tab->prerender_uri, uri)))
   {
-    gtk_widget_modify_fg(GTK_WIDGET(show_command),     GTK_STATE_NORMAL, &(Jumanji.Style.completion_g_fg));
-    gtk_widget_modify_fg(GTK_WIDGET(show_description), GTK_STATE_NORMAL, &(Jumanji.Style.completion_g_fg));
-    gtk_widget_modify_bg(GTK_WIDGET(row),              GTK_STATE_NORMAL, &(Jumanji.Style.completion_g_bg));
+    g_free(uri);
+    return;
   }
-  else
+
+  /* one prerender per tab, and none once the memory is used up */
+  prerender_drop(tab);
+
+  if(resident_memory() > (gint64) prerender_memory * 1024 * 1024)
   {
-    gtk_widget_modify_fg(GTK_WIDGET(show_command),     GTK_STATE_NORMAL, &(Jumanji.Style.completion_fg));
-    gtk_widget_modify_fg(GTK_WIDGET(show_description), GTK_STATE_NORMAL, &(Jumanji.Style.completion_fg));
-    gtk_widget_modify_bg(GTK_WIDGET(row),              GTK_STATE_NORMAL, &(Jumanji.Style.completion_bg));
+    g_free(uri);
+    return;
   }
 
-  gtk_widget_modify_font(GTK_WIDGET(show_command),     Jumanji.Style.font);
-  gtk_widget_modify_font(GTK_WIDGET(show_description), Jumanji.Style.font);
+  Tab* p = g_malloc0(sizeof(Tab));
+  p->id     = Jumanji.Tabs.next_id++;
+  p->owner  = tab;
+  p->widget = gtk_scrolled_window_new(NULL, NULL);
+  p->view   = create_view(p);
 
-  gtk_box_pack_start(GTK_BOX(col), GTK_WIDGET(show_command),     TRUE,  TRUE,  2);
-  gtk_box_pack_start(GTK_BOX(col), GTK_WIDGET(show_description), FALSE, FALSE, 2);
+  g_object_set_data(G_OBJECT(p->widget), "tab", p);
 
-  gtk_container_add(GTK_CONTAINER(row), GTK_WIDGET(col));
+  /* the offscreen window lays the page out at the size of the tab */
+  GtkAllocation allocation;
+  gtk_widget_get_allocation(tab->widget, &allocation);
 
-  gtk_box_pack_start(results, GTK_WIDGET(row), FALSE, FALSE, 0);
-  gtk_widget_show_all(GTK_WIDGET(row));
+  GtkWidget* window = gtk_offscreen_window_new();
+  gtk_widget_set_size_request(p->widget, allocation.width, allocation.height);
+  gtk_container_add(GTK_CONTAINER(p->widget), GTK_WIDGET(p->view));
+  gtk_container_add(GTK_CONTAINER(window), p->widget);
+  gtk_widget_show_all(window);
 
-  return row;
-}
+  /* the copied settings still hold the hiding sheet of the tab */
+  p->stylesheet      = g_strdup(tab->stylesheet);
+  p->user_stylesheet = g_strdup(tab->user_stylesheet);
 
-Completion*
-completion_init()
-{
-  Completion *completion = malloc(sizeof(Completion));
-  if(!completion)
-    out_of_memory();
+  webkit_web_view_set_zoom_level(p->view, webkit_web_view_get_zoom_level(tab->view));
 
-  completion->groups = NULL;
+  /* going back from the swapped in page walks the history of the tab,
+   * the back list starts with the item closest to the current one */
+  WebKitWebBackForwardList* history = webkit_web_view_get_back_forward_list(tab->view);
+  GList* items = webkit_web_back_forward_list_get_back_list_with_limit(history,
+      webkit_web_back_forward_list_get_back_length(history));
+  items = g_list_prepend(items, webkit_web_back_forward_list_get_current_item(history));
 
-  return completion;
+  for(GList* l = g_list_last(items); l; l = l->prev)
+  {
+    if(!l->data)
+      continue;
+
+    WebKitWebHistoryItem* item = webkit_web_history_item_copy(WEBKIT_WEB_HISTORY_ITEM(l->data));
+    webkit_web_back_forward_list_add_item(webkit_web_view_get_back_forward_list(p->view), item);
+    g_object_unref(item);
+  }
+
+  g_list_free(items);
+
+  tab->prerender     = p;
+  tab->prerender_uri = uri;
+
+  webkit_web_view_load_uri(p->view, uri);
 }
 
-CompletionGroup*
-completion_group_create(char* name)
+void
+prerender_swap(Tab* tab)
 {
-  CompletionGroup* group = malloc(sizeof(CompletionGroup));
-  if(!group)
-    out_of_memory();
+  Tab* p = tab->prerender;
 
-  group->value    = name;
-  group->elements = NULL;
-  group->next     = NULL;
+  if(!p)
+    return;
 
-  return group;
+  tab->prerender = NULL;
+  g_free(tab->prerender_uri);
+  tab->prerender_uri = NULL;
+
+  /* exchange the views between the scrolled windows */
+  GtkWidget* shown  = GTK_WIDGET(tab->view);
+  GtkWidget* hidden = GTK_WIDGET(p->view);
+
+  g_object_ref(shown);
+  g_object_ref(hidden);
+  gtk_container_remove(GTK_CONTAINER(tab->widget), shown);
+  gtk_container_remove(GTK_CONTAINER(p->widget), hidden);
+  gtk_container_add(GTK_CONTAINER(tab->widget), hidden);
+  gtk_container_add(GTK_CONTAINER(p->widget), shown);
+  g_object_unref(shown);
+  g_object_unref(hidden);
+
+  g_signal_handlers_disconnect_matched(G_OBJECT(shown),  G_SIGNAL_MATCH_DATA, 0, 0, NULL, NULL, tab);
+  g_signal_handlers_disconnect_matched(G_OBJECT(hidden), G_SIGNAL_MATCH_DATA, 0, 0, NULL, NULL, p);
+  connect_view(WEBKIT_WEB_VIEW(hidden), tab);
+  connect_view(WEBKIT_WEB_VIEW(shown),  p);
+
+  /* the page state moves along with the view */
+  tab->view = WEBKIT_WEB_VIEW(hidden);
+  p->view   = WEBKIT_WEB_VIEW(shown);
+
+  int injections = tab->injections;
+  tab->injections = p->injections;
+  p->injections   = injections;
+
+  int frames = tab->frames;
+  tab->frames = p->frames;
+  p->frames   = frames;
+
+  GPtrArray* scripts = tab->scripts;
+  tab->scripts = p->scripts;
+  p->scripts   = scripts;
+
+  int script_generation = tab->script_generation;
+  tab->script_generation = p->script_generation;
+  p->script_generation   = script_generation;
+
+  char* stylesheet = tab->stylesheet;
+  tab->stylesheet = p->stylesheet;
+  p->stylesheet   = stylesheet;
+
+  char* user_stylesheet = tab->user_stylesheet;
+  tab->user_stylesheet = p->user_stylesheet;
+  p->user_stylesheet   = user_stylesheet;
+
+  int blocked = tab->blocked;
+  tab->blocked = p->blocked;
+  p->blocked   = blocked;
+
+  GPtrArray* requests = tab->requests;
+  tab->requests = p->requests;
+  p->requests   = requests;
+
+  /* page scripts of the main frame reach the tab through the bridge */
+  JSContextRef context = webkit_web_frame_get_global_context(webkit_web_view_get_main_frame(tab->view));
+  JSStringRef  name    = JSStringCreateWithUTF8CString("jumanji");
+  JSValueRef   bridge  = JSObjectGetProperty(context, JSContextGetGlobalObject(context), name, NULL);
+  JSStringRelease(name);
+
+  if(bridge && JSValueIsObject(context, bridge))
+    JSObjectSetPrivate(JSValueToObject(context, bridge, NULL), GINT_TO_POINTER(tab->id));
+
+  if(Jumanji.Hints.tab == tab)
+  {
+    hints_reset();
+
+    if(Jumanji.Global.mode == FOLLOW)
+      change_mode(NORMAL);
+  }
+
+  /* the old view may still be emitting the signal that led here */
+  g_idle_add(cb_prerender_free, p);
+
+  /* a page that has finished loading offscreen can prerender its own next one */
+  if(webkit_web_view_get_load_status(tab->view) == WEBKIT_LOAD_FINISHED)
+    prerender_start(tab);
+
+  if(tab == Jumanji.Tabs.current)
+  {
+    gtk_widget_grab_focus(GTK_WIDGET(tab->widget));
+    mark_dirty(DIRTY_URI | DIRTY_TITLE);
+  }
+
+  mark_tab_dirty(tab);
 }
 
 void
-completion_add_group(Completion* completion, CompletionGroup* group)
+profile_script(const char* name, const char* caller, gint64 start, gboolean failed)
 {
-  CompletionGroup* cg = completion->groups;
+  if(!Jumanji.Global.profiles)
+    return;
 
-  while(cg && cg->next)
-    cg = cg->next;
+  double elapsed = (g_get_monotonic_time() - start) / 1000.0;
+  char*  key     = g_strconcat(caller, "\n", name, NULL);
 
-  if(cg)
-    cg->next = group;
+  ScriptProfile* profile = g_hash_table_lookup(Jumanji.Global.profiles, key);
+
+  if(!profile)
+  {
+    profile = g_malloc0(sizeof(ScriptProfile));
+    profile->script = g_strdup(name);
+    profile->caller = g_strdup(caller);
+    g_hash_table_insert(Jumanji.Global.profiles, key, profile);
+  }
   else
-    completion->groups = group;
+    g_free(key);
+
+  profile->calls++;
+  profile->total += elapsed;
+
+  if(elapsed > profile->max)
+    profile->max = elapsed;
+  if(failed)
+    profile->exceptions++;
 }
 
-void completion_free(Completion* completion)
+void
+free_request_timing(gpointer data)
 {
-  CompletionGroup* group = completion->groups;
-  CompletionElement *element;
+  RequestTiming* timing = (RequestTiming*) data;
 
-  while(group)
+  /* a request still in flight stops recording into the freed timing */
+  if(timing->message)
   {
-    element = group->elements;
-    while(element)
-    {
-      CompletionElement* ne = element->next;
-      free(element);
-      element = ne;
-    }
-
-    CompletionGroup *ng = group->next;
-    free(group);
-    group = ng;
+    g_object_set_data(G_OBJECT(timing->message), TIMING_DATA, NULL);
+    g_object_remove_weak_pointer(G_OBJECT(timing->message), (gpointer*) &timing->message);
   }
+
+  g_free(timing->method);
+  g_free(timing->uri);
+  g_free(timing->mime_type);
+  g_free(timing->status_text);
+  g_free(timing);
 }
 
-void completion_group_add_element(CompletionGroup* group, char* name, char* description)
+void
+free_script_profile(gpointer data)
 {
-  CompletionElement* el = group->elements;
+  ScriptProfile* profile = (ScriptProfile*) data;
 
-  while(el && el->next)
-    el = el->next;
+  g_free(profile->script);
+  g_free(profile->caller);
+  g_free(profile);
+}
 
-  CompletionElement* new_element = malloc(sizeof(CompletionElement));
-  if(!new_element)
-    out_of_memory();
+gint
+compare_script_profiles(gconstpointer a, gconstpointer b)
+{
+  double ta = ((const ScriptProfile*) a)->total;
+  double tb = ((const ScriptProfile*) b)->total;
 
-  new_element->value       = name;
-  new_element->description = description;
-  new_element->next        = NULL;
+  return (ta < tb) - (ta > tb);
+}
 
-  if(el)
-    el->next = new_element;
-  else
-    group->elements = new_element;
+/* the hint engine collects the clickable elements of the visible part of the
+ * page once, everything else is done in C on the compact hint table */
+static const char hint_engine[] =
+  "(function() {"
+  "  var hints = [], box = null, active = -1;"
+  "  function clear() {"
+  "    if(box && box.parentNode) box.parentNode.removeChild(box);"
+  "    box = null; hints = []; active = -1;"
+  "  }"
+  "  return {"
+  "    collect: function() {"
+  "      clear();"
+  "      var w = window.innerWidth, h = window.innerHeight, texts = [];"
+  "      var elements = document.querySelectorAll('a[href], area[href], input:not([type=hidden]), textarea, select, button, [onclick], [role=button], [role=link]');"
+  "      box = document.createElement('div');"
+  "      for(var i = 0; i < elements.length; i++) {"
+  "        var r = elements[i].getBoundingClientRect();"
+  "        if(!r.width || !r.height || r.bottom < 0 || r.right < 0 || r.top > h || r.left > w) continue;"
+  "        var l = document.createElement('span');"
+  "        l.style.cssText = 'position:absolute;z-index:2147483647;display:none;padding:0 2px;font:bold 10px monospace;color:#000;background:#ff0;border:1px solid #000;'"
+  "          + 'left:' + (r.left + window.scrollX) + 'px;top:' + (r.top + window.scrollY) + 'px';"
+  "        box.appendChild(l);"
+  "        hints.push([elements[i], l]);"
+  "        texts.push((elements[i].textContent || elements[i].value || '').substr(0, 64).replace(/\\s+/g, ' ').toLowerCase());"
+  "      }"
+  "      (document.body || document.documentElement).appendChild(box);"
+  "      return hints.length + '\\n' + texts.join('\\n');"
+  "    },"
+  "    label: function(i, n) {"
+  "      hints[i][1].style.display = n ? 'inline' : 'none';"
+  "      if(n) hints[i][1].textContent = n;"
+  "    },"
+  "    focus: function(i) {"
+  "      if(active >= 0) hints[active][1].style.background = '#ff0';"
+  "      active = i;"
+  "      hints[i][1].style.background = '#f80';"
+  "      var e = hints[i][0];"
+  "      return (e.href && e.href.indexOf('javascript:') != 0) ? e.href : '';"
+  "    },"
+  "    follow: function(i) {"
+  "      var e = hints[i][0], t = e.tagName;"
+  "      clear();"
+  "      if((t == 'A' || t == 'AREA') && e.href && e.href.indexOf('javascript:') != 0) return e.href;"
+  "      if((t == 'INPUT' && !/^(button|submit|reset|checkbox|radio|image|file)$/i.test(e.type)) || t == 'TEXTAREA' || t == 'SELECT') {"
+  "        e.focus();"
+  "        if(window.jumanji) jumanji.mode('insert');"
+  "        return '';"
+  "      }"
+  "      var ev = document.createEvent('MouseEvents');"
+  "      ev.initMouseEvent('click', true, true, window, 0, 0, 0, 0, 0, false, false, false, false, 0, null);"
+  "      e.dispatchEvent(ev);"
+  "      return '';"
+  "    },"
+  "    clear: clear"
+  "  };"
+  "})()";
+
+JSValueRef
+hints_call(JSObjectRef function, int first, int second)
+{
+  if(!Jumanji.Hints.engine || !function)
+    return NULL;
+
+  JSContextRef context = webkit_web_frame_get_global_context(
+      webkit_web_view_get_main_frame(Jumanji.Hints.tab->view));
+  JSValueRef arguments[2] = { JSValueMakeNumber(context, first), JSValueMakeNumber(context, second) };
+  JSValueRef exception    = NULL;
+  gint64     start        = g_get_monotonic_time();
+
+  JSValueRef result = JSObjectCallAsFunction(context, function, Jumanji.Hints.engine, 2, arguments, &exception);
+  profile_script("hint engine", "hints", start, exception != NULL);
+
+  return result;
 }
 
-/* shortcut implementation */
-void
-sc_abort(Argument* UNUSED(argument))
+JSObjectRef
+hints_method(JSContextRef context, const char* name)
 {
-  /* Clear buffer */
-  if(Jumanji.Global.buffer)
+  JSStringRef property = JSStringCreateWithUTF8CString(name);
+  JSValueRef  value    = JSObjectGetProperty(context, Jumanji.Hints.engine, property, NULL);
+  JSStringRelease(property);
+
+  return (value && JSValueIsObject(context, value)) ? JSValueToObject(context, value, NULL) : NULL;
+}
+
+gboolean
+hints_show()
+{
+  Tab* tab = Jumanji.Hints.tab ? Jumanji.Hints.tab : Jumanji.Tabs.current;
+
+  if(!tab)
+    return FALSE;
+
+  JSContextRef context = webkit_web_frame_get_global_context(webkit_web_view_get_main_frame(tab->view));
+
+  if(!context)
+    return FALSE;
+
+  /* the engine lives as long as the hints are shown, the hint table is
+   * rebuilt whenever the visible part of the page changed */
+  if(!Jumanji.Hints.engine)
   {
-    g_string_free(Jumanji.Global.buffer, TRUE);
-    Jumanji.Global.buffer = NULL;
-    gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.buffer, "");
+    static JSStringRef source = NULL;
+    if(!source)
+      source = JSStringCreateWithUTF8CString(hint_engine);
+
+    JSValueRef engine = evaluate_script(context, source, "hint engine", "hints", NULL);
+    if(!engine || !JSValueIsObject(context, engine))
+      return FALSE;
+
+    Jumanji.Hints.tab    = tab;
+    Jumanji.Hints.engine = JSValueToObject(context, engine, NULL);
+    JSValueProtect(context, Jumanji.Hints.engine);
+
+    Jumanji.Hints.label  = hints_method(context, "label");
+    Jumanji.Hints.focus  = hints_method(context, "focus");
+    Jumanji.Hints.follow = hints_method(context, "follow");
+    Jumanji.Hints.clear  = hints_method(context, "clear");
   }
 
-  /* Clear hints */
-  char* cmd = "clear()";
-  run_script(cmd, NULL, NULL);
+  JSObjectRef collect = hints_method(context, "collect");
+  JSValueRef  result  = NULL;
 
-  /* Stop loading website */
-  if(webkit_web_view_get_progress(GET_CURRENT_TAB()) == 1.0)
-    cmd_stop(0, NULL);
+  if(collect)
+  {
+    JSValueRef exception = NULL;
+    gint64     start     = g_get_monotonic_time();
 
-  /* Set back to normal mode */
-  change_mode(NORMAL);
+    result = JSObjectCallAsFunction(context, collect, Jumanji.Hints.engine, 0, NULL, &exception);
+    profile_script("hint engine", "hints", start, exception != NULL);
+  }
 
-  /* Hide inputbar */
-  gtk_widget_hide(GTK_WIDGET(Jumanji.UI.inputbar));
+  char* texts = reference_to_string(context, result);
 
-  /* Unmark search results */
-  webkit_web_view_unmark_text_matches(GET_CURRENT_TAB());
+  if(!texts)
+  {
+    hints_reset();
+    return FALSE;
+  }
 
-  gtk_widget_grab_focus(GTK_WIDGET(GET_CURRENT_TAB_WIDGET()));
+  /* the texts are kept in the returned buffer, the table only points into it */
+  g_free(Jumanji.Hints.texts);
+  g_free(Jumanji.Hints.filter);
+  Jumanji.Hints.texts   = texts;
+  Jumanji.Hints.filter  = NULL;
+  Jumanji.Hints.length  = atoi(texts);
+  Jumanji.Hints.list    = g_renew(Hint, Jumanji.Hints.list, Jumanji.Hints.length);
+  Jumanji.Hints.matches = 0;
+  Jumanji.Hints.first   = -1;
+  Jumanji.Hints.active  = -1;
+
+  char* text = strchr(texts, '\n');
+  for(int i = 0; i < Jumanji.Hints.length; i++)
+  {
+    text = text ? text + 1 : "";
+
+    Jumanji.Hints.list[i].number = 0;
+    Jumanji.Hints.list[i].shown  = 0;
+    Jumanji.Hints.list[i].text   = text;
+
+    if((text = strchr(text, '\n')))
+      *text = '\0';
+  }
+
+  hints_filter(Jumanji.Global.buffer ? Jumanji.Global.buffer->str : "", TRUE);
+
+  return TRUE;
 }
 
 void
-sc_change_buffer(Argument* argument)
+hints_filter(const char* buffer, gboolean renumber)
 {
-  if(!Jumanji.Global.buffer)
+  if(!Jumanji.Hints.engine)
     return;
 
-  int buffer_length = Jumanji.Global.buffer->len;
+  /* letters filter the hints by their text and renumber them, digits select
+   * by label; only hints whose label changed are touched in the page */
+  GString* text   = g_string_new(NULL);
+  GString* digits = g_string_new(NULL);
 
-  if(argument->n == DELETE_LAST_CHAR)
+  for(const char* c = buffer; *c; c++)
   {
-    if((buffer_length - 1) == 0)
-    {
-      g_string_free(Jumanji.Global.buffer, TRUE);
-      Jumanji.Global.buffer = NULL;
-      gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.buffer, "");
-    }
+    if(g_ascii_isdigit(*c))
+      g_string_append_c(digits, *c);
     else
-    {
-      GString* temp = g_string_new_len(Jumanji.Global.buffer->str, buffer_length - 1);
-      g_string_free(Jumanji.Global.buffer, TRUE);
-      Jumanji.Global.buffer = temp;
-      gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.buffer, Jumanji.Global.buffer->str);
-    }
-
-    if(Jumanji.Global.mode == FOLLOW)
-    {
-      Argument argument = {0, NULL};
-      sc_follow_link(&argument);
-    }
+      g_string_append_c(text, g_ascii_tolower(*c));
   }
-}
 
-void
-sc_change_mode(Argument* argument)
-{
-  if(argument)
-    change_mode(argument->n);
-}
+  if(Jumanji.Hints.filter && !strcmp(Jumanji.Hints.filter, buffer) && !renumber)
+  {
+    g_string_free(text, TRUE);
+    g_string_free(digits, TRUE);
+    return;
+  }
 
-void
-sc_close_tab(Argument* UNUSED(argument))
-{
-  int current_tab = gtk_notebook_get_current_page(Jumanji.UI.view);
-  close_tab(current_tab);
-}
+  char* previous = NULL;
+  if(Jumanji.Hints.filter && !renumber)
+  {
+    GString* old = g_string_new(NULL);
+    for(const char* c = Jumanji.Hints.filter; *c; c++)
+      if(!g_ascii_isdigit(*c))
+        g_string_append_c(old, g_ascii_tolower(*c));
+    previous = g_string_free(old, FALSE);
+  }
 
-void
-sc_focus_inputbar(Argument* argument)
-{
-  if(argument->data)
+  if(!previous || strcmp(previous, text->str))
   {
-    char* data = argument->data;
+    /* a longer text can only match hints that matched the shorter one */
+    gboolean narrowed = previous && g_str_has_prefix(text->str, previous);
+    int number = 0;
 
-    if(argument->n == APPEND_URL)
-      data = g_strdup_printf("%s%s", data, webkit_web_view_get_uri(GET_CURRENT_TAB()));
-    else
-      data = g_strdup(data);
+    for(int i = 0; i < Jumanji.Hints.length; i++)
+    {
+      Hint* hint = &(Jumanji.Hints.list[i]);
 
-    notify(DEFAULT, data);
-    g_free(data);
+      if(narrowed && !hint->number)
+        continue;
+
+      hint->number = (!text->len || strstr(hint->text, text->str)) ? ++number : 0;
+    }
+  }
 
-    /* we save the X clipboard that will be clear by "grab_focus" */
-    gchar* x_clipboard_text = gtk_clipboard_wait_for_text(gtk_clipboard_get(GDK_SELECTION_PRIMARY));
+  Jumanji.Hints.matches = 0;
+  Jumanji.Hints.first   = -1;
 
-    gtk_widget_grab_focus(GTK_WIDGET(Jumanji.UI.inputbar));
-    gtk_editable_set_position(GTK_EDITABLE(Jumanji.UI.inputbar), -1);
+  for(int i = 0; i < Jumanji.Hints.length; i++)
+  {
+    Hint* hint = &(Jumanji.Hints.list[i]);
+    int shown  = hint->number;
 
-    if (x_clipboard_text != NULL)
+    if(shown && digits->len)
     {
-      /* we reset the X clipboard with saved text */
-      gtk_clipboard_set_text(gtk_clipboard_get(GDK_SELECTION_PRIMARY), x_clipboard_text, -1);
+      char label[16];
+      snprintf(label, sizeof(label), "%d", shown);
+      if(strncmp(label, digits->str, digits->len))
+        shown = 0;
+    }
+
+    if(shown)
+    {
+      if(Jumanji.Hints.first < 0)
+        Jumanji.Hints.first = i;
+      Jumanji.Hints.matches++;
+    }
 
-      g_free(x_clipboard_text);
+    if(shown != hint->shown)
+    {
+      hints_call(Jumanji.Hints.label, i, shown);
+      hint->shown = shown;
     }
   }
 
-  if(!(GTK_WIDGET_VISIBLE(GTK_WIDGET(Jumanji.UI.inputbar))))
-    gtk_widget_show(GTK_WIDGET(Jumanji.UI.inputbar));
+  if(Jumanji.Hints.active >= 0 && !Jumanji.Hints.list[Jumanji.Hints.active].shown)
+    Jumanji.Hints.active = -1;
+
+  g_free(previous);
+  g_free(Jumanji.Hints.filter);
+  Jumanji.Hints.filter = g_strdup(buffer);
+
+  g_string_free(text, TRUE);
+  g_string_free(digits, TRUE);
 }
 
-void
-sc_follow_link(Argument* argument)
+int
+hints_focus(int direction)
 {
-  static gboolean follow_links = FALSE;
-  static int      open_mode    = -1;
-  GdkEventKey *key = (GdkEventKey*)argument->data;
+  if(!Jumanji.Hints.matches)
+    return -1;
 
-  /* update open mode */
-  if(argument->n < 0)
-    open_mode = argument->n;
+  /* without a focused hint the first step lands on the first or the last one */
+  int i = Jumanji.Hints.active;
+  if(i < 0)
+    i = direction > 0 ? -1 : 0;
 
-  /* show all links */
-  if(!follow_links || Jumanji.Global.mode != FOLLOW)
+  do
   {
-    run_script("show_hints()", NULL, NULL);
-    change_mode(FOLLOW);
-    follow_links = TRUE;
-    return;
-  }
+    i = (i + direction + Jumanji.Hints.length) % Jumanji.Hints.length;
+  } while(!Jumanji.Hints.list[i].shown);
 
-  char* value = NULL;
-  char* cmd   = NULL;
+  JSContextRef context = webkit_web_frame_get_global_context(
+      webkit_web_view_get_main_frame(Jumanji.Hints.tab->view));
+  char* uri = reference_to_string(context, hints_call(Jumanji.Hints.focus, i, 0));
+  Jumanji.Hints.active = i;
 
-  if (argument && argument->n == 10)
-    cmd = g_strdup("get_active()");
-  else if (key && key->keyval == GDK_Tab) {
-    if ( key->state & GDK_CONTROL_MASK)
-      cmd = g_strdup("focus_prev()");
-    else
-      cmd = g_strdup("focus_next()");
-  }
-  else if(Jumanji.Global.buffer && Jumanji.Global.buffer->len > 0)
-    cmd = g_strconcat("update_hints(\"", Jumanji.Global.buffer->str, "\")", NULL);
+  /* the focused link is likely to be followed next */
+  speculate(uri);
+  g_free(uri);
 
-  run_script(cmd, &value, NULL);
-  g_free(cmd);
+  return i;
+}
 
-  if(value && strcmp(value, "undefined"))
-  {
-    if(open_mode == -1)
-      open_uri(GET_CURRENT_TAB(), value);
-    else
-      create_tab(value, TRUE);
+char*
+hints_follow(int i)
+{
+  if(!Jumanji.Hints.engine || i < 0 || i >= Jumanji.Hints.length)
+    return NULL;
 
-    sc_abort(NULL);
-  }
+  JSContextRef context = webkit_web_frame_get_global_context(
+      webkit_web_view_get_main_frame(Jumanji.Hints.tab->view));
+  char* uri = reference_to_string(context, hints_call(Jumanji.Hints.follow, i, 0));
+
+  hints_reset();
+
+  return uri;
 }
 
 void
-sc_nav_history(Argument* argument)
+hints_clear()
 {
-  if(argument->n == NEXT)
-    webkit_web_view_go_forward(GET_CURRENT_TAB());
-  else if(argument->n == PREVIOUS)
-    webkit_web_view_go_back(GET_CURRENT_TAB());
+  hints_call(Jumanji.Hints.clear, 0, 0);
+  hints_reset();
 }
 
 void
-sc_nav_tabs(Argument* argument)
+hints_reset()
+{
+  if(Jumanji.Hints.rescan_id)
+    g_source_remove(Jumanji.Hints.rescan_id);
+
+  if(Jumanji.Hints.engine)
+    JSValueUnprotect(webkit_web_frame_get_global_context(
+          webkit_web_view_get_main_frame(Jumanji.Hints.tab->view)), Jumanji.Hints.engine);
+
+  g_free(Jumanji.Hints.list);
+  g_free(Jumanji.Hints.texts);
+  g_free(Jumanji.Hints.filter);
+
+  Jumanji.Hints.tab       = NULL;
+  Jumanji.Hints.engine    = NULL;
+  Jumanji.Hints.list      = NULL;
+  Jumanji.Hints.length    = 0;
+  Jumanji.Hints.texts     = NULL;
+  Jumanji.Hints.filter    = NULL;
+  Jumanji.Hints.matches   = 0;
+  Jumanji.Hints.rescan_id = 0;
+}
+
+gboolean
+is_offline_request(SoupMessage* message)
 {
-  bcmd_nav_tabs(NULL, argument);
+  /* the cache revalidates with a new message that copies the request
+   * headers, so the mark is kept in them */
+  return offline || soup_message_headers_get_one(message->request_headers, OFFLINE_HEADER);
 }
 
 void
-sc_paste(Argument* argument)
+install_bridge(JSContextRef context, Tab* tab)
 {
-  gchar* text = gtk_clipboard_wait_for_text(gtk_clipboard_get(GDK_SELECTION_PRIMARY));
+  if(!Jumanji.Global.bridge)
+  {
+    JSClassDefinition definition = kJSClassDefinitionEmpty;
+    definition.className = "Jumanji";
+    Jumanji.Global.bridge = JSClassCreate(&definition);
+  }
 
-  if(argument->n == NEW_TAB)
-    create_tab(text, FALSE);
-  else
-    open_uri(GET_CURRENT_TAB(), text);
+  /* the hint engine and user scripts call back into jumanji through this
+   * object instead of logging magic strings to the console */
+  JSObjectRef bridge = JSObjectMake(context, Jumanji.Global.bridge, GINT_TO_POINTER(tab->id));
+  JSPropertyAttributes attributes = kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontDelete;
 
-  g_free(text);
-}
+  JSStringRef name = JSStringCreateWithUTF8CString("mode");
+  JSObjectSetProperty(context, bridge, name, JSObjectMakeFunctionWithCallback(context, name, cb_js_mode), attributes, NULL);
+  JSStringRelease(name);
 
-void
-sc_reload(Argument* argument)
-{
-  if(argument->n == BYPASS_CACHE)
-    webkit_web_view_reload_bypass_cache(GET_CURRENT_TAB());
-  else
-    webkit_web_view_reload(GET_CURRENT_TAB());
+  name = JSStringCreateWithUTF8CString("jumanji");
+  JSObjectSetProperty(context, JSContextGetGlobalObject(context), name, bridge,
+      attributes | kJSPropertyAttributeDontEnum, NULL);
+  JSStringRelease(name);
 }
 
 void
-sc_reopen(Argument* argument)
+add_hiding_rule(const char* domain, const char* selector)
 {
-  GList *last_closed = g_list_first(Jumanji.Global.last_closed);
+  GPtrArray* selectors = g_hash_table_lookup(Jumanji.Hiding.rules, domain);
 
-  if(last_closed)
+  if(!selectors)
   {
-    if(argument && argument->n)
-      create_tab(last_closed->data, TRUE);
-    else
-      create_tab(last_closed->data, FALSE);
-    Jumanji.Global.last_closed = g_list_remove(Jumanji.Global.last_closed, last_closed->data);
+    selectors = g_ptr_array_new_with_free_func(g_free);
+    g_hash_table_insert(Jumanji.Hiding.rules, g_strdup(domain), selectors);
   }
+
+  g_ptr_array_add(selectors, g_strdup(selector));
 }
 
 void
-sc_run_script(Argument* argument)
+apply_hiding_stylesheet(Tab* tab, const char* uri)
 {
-  if(argument->data)
-    run_script(argument->data, NULL, NULL);
-}
+  if(!g_hash_table_size(Jumanji.Hiding.rules) || !uri)
+    return;
 
-void
-sc_scroll(Argument* argument)
-{
-  GtkAdjustment* adjustment;
+  WebKitWebSettings* settings = webkit_web_view_get_settings(tab->view);
 
-  if( (argument->n == LEFT) || (argument->n == RIGHT) || (argument->n == LEFT_MAX) || (argument->n == RIGHT_MAX) )
-    adjustment = gtk_scrolled_window_get_hadjustment(GET_CURRENT_TAB_WIDGET());
-  else
-    adjustment = gtk_scrolled_window_get_vadjustment(GET_CURRENT_TAB_WIDGET());
+  char* current = NULL;
+  g_object_get(G_OBJECT(settings), "user-stylesheet-uri", &current, NULL);
 
-  gdouble view_size  = gtk_adjustment_get_page_size(adjustment);
-  gdouble value      = gtk_adjustment_get_value(adjustment);
-  gdouble max        = gtk_adjustment_get_upper(adjustment) - view_size;
+  /* anything but the sheet set here last is the user stylesheet of the tab */
+  if(!tab->stylesheet || g_strcmp0(current, tab->stylesheet))
+  {
+    g_free(tab->user_stylesheet);
+    tab->user_stylesheet = g_strdup(current);
+  }
 
-  if(argument->n == FULL_UP)
-    gtk_adjustment_set_value(adjustment, (value - view_size) < 0 ? 0 : (value - view_size));
-  else if(argument->n == FULL_DOWN)
-    gtk_adjustment_set_value(adjustment, (value + view_size) > max ? max : (value + view_size));
-  else if(argument->n == HALF_UP)
-    gtk_adjustment_set_value(adjustment, (value - (view_size / 2)) < 0 ? 0 : (value - (view_size / 2)));
-  else if(argument->n == HALF_DOWN)
-    gtk_adjustment_set_value(adjustment, (value + (view_size / 2)) > max ? max : (value + (view_size / 2)));
-  else if((argument->n == LEFT) || (argument->n == UP))
-    gtk_adjustment_set_value(adjustment, (value - scroll_step) < 0 ? 0 : (value - scroll_step));
-  else if(argument->n == TOP || argument->n == LEFT_MAX)
-    gtk_adjustment_set_value(adjustment, 0);
-  else if(argument->n == BOTTOM || argument->n == RIGHT_MAX)
-    gtk_adjustment_set_value(adjustment, max);
-  else
-    gtk_adjustment_set_value(adjustment, (value + scroll_step) > max ? max : (value + scroll_step));
-}
+  SoupURI* soup_uri = soup_uri_new(uri);
+  const char* sheet = get_hiding_stylesheet(tab->user_stylesheet, (soup_uri && soup_uri->host) ? soup_uri->host : "");
 
-void
-sc_search(Argument* argument)
-{
-  search_and_highlight(argument);
+  if(soup_uri)
+    soup_uri_free(soup_uri);
+
+  g_free(tab->stylesheet);
+  tab->stylesheet = g_strdup(sheet ? sheet : tab->user_stylesheet);
+
+  /* the stylesheet is only parsed again if the page needs another one */
+  if(g_strcmp0(current, tab->stylesheet))
+    g_object_set(G_OBJECT(settings), "user-stylesheet-uri", tab->stylesheet, NULL);
+
+  g_free(current);
 }
 
-gboolean
-sessionsave(char* session_name)
+void
+init_data()
 {
-  GString* session_uris = g_string_new("");
-
-  for (int i = 0; i < gtk_notebook_get_n_pages(Jumanji.UI.view); i++)
-  {
-    gchar* tab_uri_t = (gchar*) webkit_web_view_get_uri(GET_NTH_TAB(i));
-    gchar* tab_uri   = g_strconcat(tab_uri_t, " ", NULL);
-    session_uris     = g_string_append(session_uris, tab_uri);
+  /* read bookmarks */
+  char* bookmark_file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_BOOKMARKS, NULL);
 
-    g_free(tab_uri);
-  }
+  if(!bookmark_file)
+    return;
 
-  GList* se_list = Jumanji.Global.sessions;
-  while(se_list)
+  if(g_file_test(bookmark_file, G_FILE_TEST_IS_REGULAR))
   {
-    Session* se = se_list->data;
+    char* content = NULL;
 
-    if(g_strcmp0(se->name, session_name) == 0)
+    if(g_file_get_contents(bookmark_file, &content, NULL, NULL))
     {
-      g_free(se->uris);
-      se->uris = session_uris->str;
-
-      break;
-    }
+      gchar **lines = g_strsplit(content, "\n", -1);
+      int     n     = g_strv_length(lines) - 1;
 
-    se_list = g_list_next(se_list);
-  }
+      int i;
+      for(i = 0; i < n; i++)
+      {
+        if(!strlen(lines[i]))
+          continue;
 
-  /* if there was no session with name == session_name */
-  if(!se_list)
-  {
-    Session* se = malloc(sizeof(Session));
-    se->name = g_strdup(session_name);
-    se->uris = session_uris->str;
+        Jumanji.Global.bookmarks = g_list_append(Jumanji.Global.bookmarks, lines[i]);
+      }
 
-    Jumanji.Global.sessions = g_list_prepend(Jumanji.Global.sessions, se);
+      g_free(content);
+      g_free(lines);
+    }
   }
 
-  /* we don't free session_uris->str , just session_uris */
-  g_string_free(session_uris, FALSE);
+  g_free(bookmark_file);
 
-  return TRUE;
-}
+  /* read history */
+  char* history_file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_HISTORY, NULL);
 
-gboolean
-sessionswitch(char* session_name)
-{
-  // search for session
-  gchar** se_uris = NULL;
+  if(!history_file)
+    return;
 
-  GList* se_list = Jumanji.Global.sessions;
-  while(se_list)
+  if(g_file_test(history_file, G_FILE_TEST_IS_REGULAR))
   {
-    Session* se = se_list->data;
+    char* content = NULL;
 
-    if(g_strcmp0(se->name, session_name) == 0)
+    if(g_file_get_contents(history_file, &content, NULL, NULL))
     {
-      se_uris = g_strsplit(se->uris, " ", -1);
-      break ;
-    }
+      gchar **lines = g_strsplit(content, "\n", -1);
+      int     n     = g_strv_length(lines) - 1;
 
-    se_list = g_list_next(se_list);
-  }
+      int i;
+      for(i = 0; i < n; i++)
+      {
+        if(!strlen(lines[i]))
+          continue;
 
-  if(!se_uris)
-    return FALSE;
+        Jumanji.Global.history = g_list_prepend(Jumanji.Global.history, lines[i]);
+      }
 
-  int nb_uris = g_strv_length(se_uris) - 1;
+      Jumanji.Global.history = g_list_reverse(Jumanji.Global.history);
 
-  if(nb_uris <= 0)
-    return FALSE;
+      g_free(content);
+      g_free(lines);
+    }
+  }
 
-  /* a session have been found
-   * we can start removing all the current tabs
-   * and attached informations */
+  g_free(history_file);
 
-  // remove all markers
-  GList* list = Jumanji.Global.markers;
-  while(list)
+  /* read sessions */
+  gchar* sessions_file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_SESSIONS, NULL);
+
+  if(!sessions_file)
+    return;
+
+  if(g_file_test(sessions_file, G_FILE_TEST_IS_REGULAR))
   {
-    GList* next_marker = g_list_next(list);
+    char* content = NULL;
 
-    Marker* marker = (Marker*) list->data;
-    Jumanji.Global.markers = g_list_delete_link(Jumanji.Global.markers, list);
-    free(marker);
+    if(g_file_get_contents(sessions_file, &content, NULL, NULL))
+    {
+      gchar **lines = g_strsplit(content, "\n", -1);
+      int     n     = g_strv_length(lines) - 1;
 
-    list = next_marker;
-  }
+      for(int i = 0; i < n; i+=2)
+      {
+        if(!strlen(lines[i]) || !strlen(lines[i+1]))
+          continue;
 
-  /* remove all the tabs
-   * without updating the status bar */
-  for (int i = gtk_notebook_get_n_pages(Jumanji.UI.view) - 1; i != -1; --i)
-  {
-    GtkWidget* tab = GTK_WIDGET(GET_NTH_TAB_WIDGET(i));
+        Session* se = malloc(sizeof(Session));
+        se->name = lines[i];
+        se->uris = lines[i+1];
 
-    gtk_container_remove(GTK_CONTAINER(Jumanji.UI.tabbar), GTK_WIDGET(g_object_get_data(G_OBJECT(tab), "tab")));
+        Jumanji.Global.sessions = g_list_prepend(Jumanji.Global.sessions, se);
+      }
 
-    gtk_notebook_remove_page(Jumanji.UI.view, i);
+      g_free(content);
+      g_free(lines);
+    }
   }
 
-  // load the session
-  for(int i = 0; i < nb_uris; i++)
-    create_tab(se_uris[i], TRUE);
+  g_free(sessions_file);
 
-  g_strfreev(se_uris);
-  return TRUE;
-}
+  /* cookies are stored in one file per base domain and loaded when the
+   * domain is first requested, the old cookie file is split up once */
+  char* cookie_file  = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_COOKIES, NULL);
+  char* cookie_store = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_COOKIE_STORE, NULL);
 
-gboolean
-sessionload(char* session_name)
-{
-  GList* se_list = Jumanji.Global.sessions;
-  while(se_list)
+  if(!g_file_test(cookie_store, G_FILE_TEST_IS_DIR))
   {
-    Session* se = se_list->data;
+    g_mkdir_with_parents(cookie_store, 0700);
+    cookies_import(cookie_file, cookie_store);
+  }
 
-    if(g_strcmp0(se->name, session_name) == 0)
-    {
-      gchar** uris = g_strsplit(se->uris, " ", -1);
-      int     n    = g_strv_length(uris) - 1;
+  GDir* cookie_dir = g_dir_open(cookie_store, 0, NULL);
+  for(const char* name; cookie_dir && (name = g_dir_read_name(cookie_dir));)
+    g_hash_table_insert(Jumanji.Cookies.domains, g_strdup(name), GINT_TO_POINTER(FALSE));
 
-      if(n <= 0)
-        return FALSE;
+  if(cookie_dir)
+    g_dir_close(cookie_dir);
 
-      for(int i = 0; i < n; i++)
-        create_tab(uris[i], TRUE);
+  Jumanji.Cookies.jar = soup_cookie_jar_new();
+  g_signal_connect(G_OBJECT(Jumanji.Cookies.jar), "changed", G_CALLBACK(cb_cookie_changed), NULL);
 
-      g_strfreev(uris);
-      return TRUE;
-    }
+  soup_session_add_feature(Jumanji.Soup.session, (SoupSessionFeature*) Jumanji.Cookies.jar);
+  g_free(cookie_file);
+  g_free(cookie_store);
 
-    se_list = g_list_next(se_list);
-  }
+  /* http cache, evicts the least recently used entries above its size */
+  char* cache_dir    = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_CACHE, NULL);
+  Jumanji.Soup.cache = soup_cache_new(cache_dir, SOUP_CACHE_SINGLE_USER);
 
-  return FALSE;
+  /* the limit is a guint of bytes */
+  soup_cache_set_max_size(Jumanji.Soup.cache, (guint) CLAMP(cache_size, 0, 4095) * 1024 * 1024);
+  soup_cache_load(Jumanji.Soup.cache);
+  soup_session_add_feature(Jumanji.Soup.session, SOUP_SESSION_FEATURE(Jumanji.Soup.cache));
+  g_free(cache_dir);
 }
 
 void
-sc_spawn(Argument* argument)
+init_directories()
 {
-  bcmd_spawn(NULL, argument);
+  /* create jumanji directory */
+  gchar *base_directory = g_build_filename(g_get_home_dir(), JUMANJI_DIR, NULL);
+  g_mkdir_with_parents(base_directory,  0771);
+  g_free(base_directory);
 }
 
 void
-sc_toggle_proxy(Argument* UNUSED(argument))
+init_keylist()
 {
-  static gboolean enable = FALSE;
-
-  if(enable)
-  {
-    g_object_set(Jumanji.Soup.session, "proxy-uri", NULL, NULL);
+  /* init shortcuts */
+  ShortcutList* e = NULL;
+  ShortcutList* p = NULL;
 
-    if(Jumanji.Global.init_ui)
-      notify(DEFAULT, "Proxy deactivated");
-  }
-  else
+  for(unsigned int i = 0; i < LENGTH(shortcuts); i++)
   {
-    char* purl = (proxy) ? proxy : (char*) g_getenv("http_proxy");
-    if(!purl)
-    {
-      if(Jumanji.Global.init_ui)
-        notify(DEFAULT, "No proxy defined");
-      return;
-    }
-
-    char* uri = strstr(purl, "://") ? g_strdup(purl) : g_strconcat("http://", purl, NULL);
-    SoupURI* proxy_uri = soup_uri_new(uri);
+    e = malloc(sizeof(ShortcutList));
+    if(!e)
+      out_of_memory();
 
-    g_object_set(Jumanji.Soup.session, "proxy-uri", proxy_uri, NULL);
+    e->element = shortcuts[i];
+    e->next    = NULL;
 
-    soup_uri_free(proxy_uri);
-    g_free(uri);
+    if(!Jumanji.Bindings.sclist)
+      Jumanji.Bindings.sclist = e;
+    if(p)
+      p->next = e;
 
-    if(Jumanji.Global.init_ui)
-      notify(DEFAULT, "Proxy activated");
+    p = e;
   }
 
-  enable = !enable;
-}
+  /* init buffered commands */
+  BufferCommandList *b = NULL;
+  BufferCommandList *f = NULL;
 
-void
-sc_toggle_statusbar(Argument* UNUSED(argument))
-{
-  if(GTK_WIDGET_VISIBLE(GTK_WIDGET(Jumanji.UI.statusbar)))
-    gtk_widget_hide(GTK_WIDGET(Jumanji.UI.statusbar));
-  else
-    gtk_widget_show(GTK_WIDGET(Jumanji.UI.statusbar));
-}
+  for(unsigned int i = 0; i < LENGTH(buffer_commands); i++)
+  {
+    b = malloc(sizeof(BufferCommandList));
+    if(!b)
+      out_of_memory();
 
-void
-sc_toggle_sourcecode(Argument* UNUSED(argument))
-{
-  gchar* uri = (char*) webkit_web_view_get_uri(GET_CURRENT_TAB());
+    b->element = buffer_commands[i];
+    b->next    = NULL;
 
-  if(webkit_web_view_get_view_source_mode(GET_CURRENT_TAB()))
-    webkit_web_view_set_view_source_mode(GET_CURRENT_TAB(), FALSE);
-  else
-    webkit_web_view_set_view_source_mode(GET_CURRENT_TAB(), TRUE);
+    if(!Jumanji.Bindings.bcmdlist)
+      Jumanji.Bindings.bcmdlist = b;
+    if(f)
+      f->next = b;
 
-  open_uri(GET_CURRENT_TAB(), uri);
+    f = b;
+  }
 }
 
 void
-sc_toggle_tabbar(Argument* UNUSED(argument))
+init_settings()
 {
-  if(GTK_WIDGET_VISIBLE(GTK_WIDGET(Jumanji.UI.tabbar)))
-    gtk_widget_hide(GTK_WIDGET(Jumanji.UI.tabbar));
-  else
-    gtk_widget_show(GTK_WIDGET(Jumanji.UI.tabbar));
-}
+  /* compile the colors into named styles, widgets only switch between them */
+  gchar* rc = g_strdup_printf(
+      "style \"jumanji-statusbar\" { bg[NORMAL] = \"%s\" fg[NORMAL] = \"%s\" font_name = \"%s\" }\n"
+      "style \"jumanji-statusbar-ssl\" = \"jumanji-statusbar\" { bg[NORMAL] = \"%s\" fg[NORMAL] = \"%s\" }\n"
+      "style \"jumanji-inputbar\" { base[NORMAL] = \"%s\" text[NORMAL] = \"%s\" font_name = \"%s\" }\n"
+      "style \"jumanji-inputbar-error\" = \"jumanji-inputbar\" { base[NORMAL] = \"%s\" text[NORMAL] = \"%s\" }\n"
+      "style \"jumanji-inputbar-warning\" = \"jumanji-inputbar\" { base[NORMAL] = \"%s\" text[NORMAL] = \"%s\" }\n"
+      "style \"jumanji-tab\" { bg[NORMAL] = \"%s\" fg[NORMAL] = \"%s\" font_name = \"%s\" }\n"
+      "style \"jumanji-tab-focus\" = \"jumanji-tab\" { bg[NORMAL] = \"%s\" fg[NORMAL] = \"%s\" }\n"
+      "style \"jumanji-tab-separator\" { bg[NORMAL] = \"%s\" }\n"
+      "style \"jumanji-completion\" { bg[NORMAL] = \"%s\" fg[NORMAL] = \"%s\" font_name = \"%s\" }\n"
+      "style \"jumanji-completion-group\" = \"jumanji-completion\" { bg[NORMAL] = \"%s\" fg[NORMAL] = \"%s\" }\n"
+      "style \"jumanji-completion-highlight\" = \"jumanji-completion\" { bg[NORMAL] = \"%s\" fg[NORMAL] = \"%s\" }\n"
+      "widget \"*jumanji-statusbar*\" style \"jumanji-statusbar\"\n"
+      "widget \"*jumanji-statusbar-ssl*\" style \"jumanji-statusbar-ssl\"\n"
+      "widget \"*jumanji-inputbar*\" style \"jumanji-inputbar\"\n"
+      "widget \"*jumanji-inputbar-error*\" style \"jumanji-inputbar-error\"\n"
+      "widget \"*jumanji-inputbar-warning*\" style \"jumanji-inputbar-warning\"\n"
+      "widget \"*jumanji-tab*\" style \"jumanji-tab\"\n"
+      "widget \"*jumanji-tab-focus*\" style \"jumanji-tab-focus\"\n"
+      "widget \"*jumanji-tab*GtkVSeparator\" style \"jumanji-tab-separator\"\n"
+      "widget \"*jumanji-completion*\" style \"jumanji-completion\"\n"
+      "widget \"*jumanji-completion-group*\" style \"jumanji-completion-group\"\n"
+      "widget \"*jumanji-completion-highlight*\" style \"jumanji-completion-highlight\"\n",
+      statusbar_bgcolor,      statusbar_fgcolor, font,
+      statusbar_ssl_bgcolor,  statusbar_ssl_fgcolor,
+      inputbar_bgcolor,       inputbar_fgcolor,  font,
+      notification_e_bgcolor, notification_e_fgcolor,
+      notification_w_bgcolor, notification_w_fgcolor,
+      tabbar_bgcolor,         tabbar_fgcolor,    font,
+      tabbar_focus_bgcolor,   tabbar_focus_fgcolor,
+      tabbar_separator_color,
+      completion_bgcolor,     completion_fgcolor, font,
+      completion_g_bgcolor,   completion_g_fgcolor,
+      completion_hl_bgcolor,  completion_hl_fgcolor);
+
+  gtk_rc_parse_string(rc);
+  g_free(rc);
 
-void
-sc_quit(Argument* UNUSED(argument))
-{
-  cb_destroy(NULL, NULL);
-}
+  /* statusbar */
+  set_style(GTK_WIDGET(Jumanji.UI.statusbar), "jumanji-statusbar");
 
-void
-sc_yank(Argument* argument)
-{
-  gchar* uri = (gchar*) webkit_web_view_get_uri(GET_CURRENT_TAB());
-  if (argument->n == XA_CLIPBOARD)
-    gtk_clipboard_set_text(gtk_clipboard_get(GDK_SELECTION_CLIPBOARD), uri, -1);
-  else if (argument->n == XA_SECONDARY)
-    gtk_clipboard_set_text(gtk_clipboard_get(GDK_SELECTION_SECONDARY), uri, -1);
-  else
-    gtk_clipboard_set_text(gtk_clipboard_get(GDK_SELECTION_PRIMARY), uri, -1);
+  /* inputbar */
+  set_style(GTK_WIDGET(Jumanji.UI.inputbar), "jumanji-inputbar");
 
-  gchar* message = g_strdup_printf("Yanked %s", uri);
-  notify(DEFAULT, message);
-  g_free(message);
-}
+  /* set window size */
+  gtk_window_set_default_size(GTK_WINDOW(Jumanji.UI.window), default_width, default_height);
 
-void
-sc_zoom(Argument* argument)
-{
-  bcmd_zoom(NULL, argument);
-}
+  /* set proxy */
+  sc_toggle_proxy(NULL);
 
-/* inputbar shortcut declarations */
-void
-isc_abort(Argument* UNUSED(argument))
-{
-  Argument arg = { HIDE, NULL };
-  isc_completion(&arg);
+  /* apply user agent */
+  if(!user_agent && browser_name)
+  {
+    char* current_user_agent = NULL;
+    g_object_get(G_OBJECT(Jumanji.Global.browser_settings), "user-agent", &current_user_agent, NULL);
 
-  notify(DEFAULT, "");
-  gtk_widget_grab_focus(GTK_WIDGET(GET_CURRENT_TAB_WIDGET()));
-  gtk_widget_hide(GTK_WIDGET(Jumanji.UI.inputbar));
+    char* new_user_agent = g_strconcat(current_user_agent, " ", browser_name, NULL);
+    g_object_set(G_OBJECT(Jumanji.Global.browser_settings), "user-agent", new_user_agent, NULL);
+    g_free(new_user_agent);
+  }
+  else if(user_agent)
+  {
+    g_object_set(G_OBJECT(Jumanji.Global.browser_settings), "user-agent", user_agent, NULL);
+  }
 }
 
-void
-isc_completion(Argument* argument)
+void init_ui()
 {
-  gchar *input      = gtk_editable_get_chars(GTK_EDITABLE(Jumanji.UI.inputbar), 0, -1);
-  gchar  identifier = input[0];
-  gchar *input_m    = input + 1;
-  int    length     = strlen(input_m);
+  /* window */
+  if(Jumanji.UI.embed)
+    Jumanji.UI.window = gtk_plug_new(Jumanji.UI.embed);
+  else
+    Jumanji.UI.window = gtk_window_new(GTK_WINDOW_TOPLEVEL);
 
-  if(!length && !identifier)
-  {
-    g_free(input);
-    return;
-  }
+  /* UI */
+  Jumanji.UI.box               = GTK_BOX(gtk_vbox_new(FALSE, 0));
+  Jumanji.UI.statusbar         = gtk_event_box_new();
+  Jumanji.UI.statusbar_entries = GTK_BOX(gtk_hbox_new(FALSE, 0));
+  Jumanji.UI.tabbar            = gtk_hbox_new(FALSE, 0);
+  Jumanji.UI.inputbar          = GTK_ENTRY(gtk_entry_new());
+  Jumanji.UI.view              = GTK_NOTEBOOK(gtk_notebook_new());
 
-  /* get current information*/
-  char* first_space = strstr(input_m, " ");
-  char* current_command;
-  char* current_parameter;
-  int   current_command_length;
+  /* window */
+  gtk_window_set_title(GTK_WINDOW(Jumanji.UI.window), "jumanji");
+  GdkGeometry hints = { 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+  gtk_window_set_geometry_hints(GTK_WINDOW(Jumanji.UI.window), NULL, &hints, GDK_HINT_MIN_SIZE);
+  g_signal_connect(G_OBJECT(Jumanji.UI.window), "destroy", G_CALLBACK(cb_destroy), NULL);
 
-  if(!first_space)
-  {
-    current_command          = input_m;
-    current_command_length   = length;
-    current_parameter        = NULL;
-  }
-  else
-  {
-    int offset               = abs(input_m - first_space);
-    current_command          = g_strndup(input_m, offset);
-    current_command_length   = strlen(current_command);
-    current_parameter        = input_m + offset + 1;
-  }
+  /* box */
+  gtk_box_set_spacing(Jumanji.UI.box, 0);
+  gtk_container_add(GTK_CONTAINER(Jumanji.UI.window), GTK_WIDGET(Jumanji.UI.box));
 
-  /* if the identifier does not match the command sign and
-   * the completion should not be hidden, leave this function */
-  if((identifier != ':') && (argument->n != HIDE))
-  {
-    g_free(input);
-    return;
-  }
+  /* statusbar */
+  Jumanji.Statusbar.text       = GTK_LABEL(gtk_label_new(NULL));
+  Jumanji.Statusbar.buffer     = GTK_LABEL(gtk_label_new(NULL));
+  Jumanji.Statusbar.tabs       = GTK_LABEL(gtk_label_new(NULL));
+  Jumanji.Statusbar.position   = GTK_LABEL(gtk_label_new(NULL));
 
-  /* static elements */
-  static GtkBox        *results = NULL;
-  static CompletionRow *rows    = NULL;
+  gtk_misc_set_alignment(GTK_MISC(Jumanji.Statusbar.text),     0.0, 0.0);
+  gtk_misc_set_alignment(GTK_MISC(Jumanji.Statusbar.buffer),   1.0, 0.0);
+  gtk_misc_set_alignment(GTK_MISC(Jumanji.Statusbar.tabs),     1.0, 0.0);
+  gtk_misc_set_alignment(GTK_MISC(Jumanji.Statusbar.position), 1.0, 0.0);
 
-  static int current_item = 0;
-  static int n_items      = 0;
+  gtk_misc_set_padding(GTK_MISC(Jumanji.Statusbar.text),     2.0, 4.0);
+  gtk_misc_set_padding(GTK_MISC(Jumanji.Statusbar.buffer),   2.0, 4.0);
+  gtk_misc_set_padding(GTK_MISC(Jumanji.Statusbar.tabs),     2.0, 4.0);
+  gtk_misc_set_padding(GTK_MISC(Jumanji.Statusbar.position), 2.0, 4.0);
 
-  static char *previous_command   = NULL;
-  static char *previous_parameter = NULL;
-  static int   previous_id        = 0;
-  static int   previous_length    = 0;
+  gtk_box_pack_start(Jumanji.UI.statusbar_entries, GTK_WIDGET(Jumanji.Statusbar.text),     TRUE,   TRUE, 2);
+  gtk_box_pack_start(Jumanji.UI.statusbar_entries, GTK_WIDGET(Jumanji.Statusbar.buffer),   FALSE, FALSE, 2);
+  gtk_box_pack_start(Jumanji.UI.statusbar_entries, GTK_WIDGET(Jumanji.Statusbar.tabs),     FALSE, FALSE, 2);
+  gtk_box_pack_start(Jumanji.UI.statusbar_entries, GTK_WIDGET(Jumanji.Statusbar.position), FALSE, FALSE, 2);
 
-  static gboolean command_mode = TRUE;
+  gtk_container_add(GTK_CONTAINER(Jumanji.UI.statusbar), GTK_WIDGET(Jumanji.UI.statusbar_entries));
 
-  /* delete old list iff
-   *   the completion should be hidden
-   *   the current command differs from the previous one
-   *   the current parameter differs from the previous one
-   */
-  if( (argument->n == HIDE) ||
-      (current_parameter && previous_parameter && strcmp(current_parameter, previous_parameter)) ||
-      (current_command && previous_command && strcmp(current_command, previous_command)) ||
-      (previous_length != length)
-    )
-  {
-    if(results)
-      gtk_widget_destroy(GTK_WIDGET(results));
+  /* inputbar */
+  gtk_entry_set_inner_border(Jumanji.UI.inputbar, NULL);
+  gtk_entry_set_has_frame(   Jumanji.UI.inputbar, FALSE);
+  gtk_editable_set_editable( GTK_EDITABLE(Jumanji.UI.inputbar), TRUE);
 
-    results = NULL;
+  g_signal_connect(G_OBJECT(Jumanji.UI.inputbar), "key-press-event", G_CALLBACK(cb_inputbar_kb_pressed), NULL);
+  g_signal_connect(GTK_EDITABLE(Jumanji.UI.inputbar), "changed",     G_CALLBACK(cb_inputbar_changed),    NULL);
+  g_signal_connect(G_OBJECT(Jumanji.UI.inputbar), "activate",        G_CALLBACK(cb_inputbar_activate),   NULL);
+  g_signal_connect(G_OBJECT(Jumanji.UI.view),     "switch-page",     G_CALLBACK(cb_notebook_switch_page), NULL);
 
-    if(rows)
-      free(rows);
+  /* tabbar, a fixed number of slots shows the tabs around the current one */
+  GtkWidget* slots = gtk_hbox_new(TRUE, 0);
 
-    rows         = NULL;
-    current_item = 0;
-    n_items      = 0;
-    command_mode = TRUE;
+  if(tabbar_size < 1)
+    tabbar_size = 1;
 
-    if(argument->n == HIDE)
-    {
-      g_free(input);
-      return;
-    }
-  }
+  Jumanji.Tabs.left  = gtk_label_new(NULL);
+  Jumanji.Tabs.right = gtk_label_new(NULL);
+  Jumanji.Tabs.n_slots = tabbar_size;
+  Jumanji.Tabs.slots   = g_malloc0(sizeof(TabSlot) * Jumanji.Tabs.n_slots);
 
-  /* create new list iff
-   *  there is no current list
-   *  the current command differs from the previous one
-   *  the current parameter differs from the previous one
-   */
-  if( (!results) )
+  for(int i = 0; i < Jumanji.Tabs.n_slots; i++)
   {
-    results = GTK_BOX(gtk_vbox_new(FALSE, 0));
-
-    /* create list based on parameters iff
-     *  there is a current parameter given
-     *  there is an old list with commands (or not)
-     *  the current command does not differ from the previous one
-     *  the current command has an completion function
-     */
-    if(strchr(input_m, ' '))
-    {
-      gboolean search_matching_command = FALSE;
+    TabSlot* slot = &(Jumanji.Tabs.slots[i]);
 
-      for(unsigned int i = 0; i < LENGTH(commands); i++)
-      {
-        int abbr_length = commands[i].abbr ? strlen(commands[i].abbr) : 0;
-        int cmd_length  = commands[i].command ? strlen(commands[i].command) : 0;
+    slot->label = gtk_label_new(NULL);
+    gtk_label_set_width_chars(GTK_LABEL(slot->label), 1.0);
+    gtk_misc_set_alignment(    GTK_MISC(slot->label), 0.0, 0.0);
+    gtk_misc_set_padding(      GTK_MISC(slot->label), 4.0, 4.0);
 
-        if( ((current_command_length <= cmd_length)  && !strncmp(current_command, commands[i].command, current_command_length)) ||
-            ((current_command_length <= abbr_length) && !strncmp(current_command, commands[i].abbr,    current_command_length))
-          )
-        {
-          if(commands[i].completion)
-          {
-            previous_command = current_command;
-            previous_id = i;
-            search_matching_command = TRUE;
-          }
-          else
-          {
-            g_free(input);
-            return;
-          }
-        }
-      }
+    GtkWidget *tab_box = gtk_hbox_new(FALSE, 0);
+    GtkWidget *tab_sep = gtk_vseparator_new();
 
-      if(!search_matching_command)
-      {
-        g_free(input);
-        return;
-      }
+    slot->event_box = gtk_event_box_new();
+    gtk_widget_set_name(slot->event_box, "jumanji-tab");
 
-      Completion *result = commands[previous_id].completion(current_parameter ? current_parameter : "");
+    gtk_box_pack_start(GTK_BOX(tab_box), slot->label, TRUE,  TRUE,  0);
+    gtk_box_pack_start(GTK_BOX(tab_box), tab_sep,     FALSE, FALSE, 0);
+    gtk_container_add(GTK_CONTAINER(slot->event_box), tab_box);
+    gtk_widget_show_all(tab_box);
 
-      if(!result || !result->groups)
-      {
-        g_free(input);
-        return;
-      }
+    g_signal_connect(GTK_OBJECT(slot->event_box), "button_press_event", G_CALLBACK(cb_tab_clicked), slot);
 
-      command_mode               = FALSE;
-      CompletionGroup* group     = NULL;
-      CompletionElement* element = NULL;
+    /* slots are only shown if there is a tab for them */
+    gtk_widget_set_no_show_all(slot->event_box, TRUE);
+    gtk_box_pack_start(GTK_BOX(slots), slot->event_box, TRUE, TRUE, 0);
+  }
 
-      rows = malloc(sizeof(CompletionRow));
-      if(!rows)
-        out_of_memory();
+  GtkWidget* left  = gtk_event_box_new();
+  GtkWidget* right = gtk_event_box_new();
+  gtk_widget_set_name(left,  "jumanji-tab");
+  gtk_widget_set_name(right, "jumanji-tab");
+  gtk_misc_set_padding(GTK_MISC(Jumanji.Tabs.left),  4.0, 4.0);
+  gtk_misc_set_padding(GTK_MISC(Jumanji.Tabs.right), 4.0, 4.0);
+  gtk_container_add(GTK_CONTAINER(left),  Jumanji.Tabs.left);
+  gtk_container_add(GTK_CONTAINER(right), Jumanji.Tabs.right);
+  gtk_widget_show(Jumanji.Tabs.left);
+  gtk_widget_show(Jumanji.Tabs.right);
+
+  /* the indicators are only shown if there are hidden tabs */
+  gtk_widget_set_no_show_all(left,  TRUE);
+  gtk_widget_set_no_show_all(right, TRUE);
+
+  gtk_box_pack_start(GTK_BOX(Jumanji.UI.tabbar), left,  FALSE, FALSE, 0);
+  gtk_box_pack_start(GTK_BOX(Jumanji.UI.tabbar), slots, TRUE,  TRUE,  0);
+  gtk_box_pack_start(GTK_BOX(Jumanji.UI.tabbar), right, FALSE, FALSE, 0);
 
-      for(group = result->groups; group != NULL; group = group->next)
-      {
-        int group_elements = 0;
+  /* view */
+  gtk_notebook_set_show_tabs(Jumanji.UI.view,   FALSE);
+  gtk_notebook_set_show_border(Jumanji.UI.view, FALSE);
 
-        for(element = group->elements; element != NULL; element = element->next)
-        {
-          if(element->value)
-          {
-            if (group->value && !group_elements)
-            {
-              rows = realloc(rows, (n_items + 1) * sizeof(CompletionRow));
-              rows[n_items].command     = group->value;
-              rows[n_items].description = NULL;
-              rows[n_items].command_id  = -1;
-              rows[n_items].is_group    = TRUE;
-              rows[n_items++].row       = GTK_WIDGET(create_completion_row(results, group->value, NULL, TRUE));
-            }
+  /* packing */
+  gtk_box_pack_start(Jumanji.UI.box, GTK_WIDGET(Jumanji.UI.tabbar),    FALSE, FALSE, 0);
+  gtk_box_pack_start(Jumanji.UI.box, GTK_WIDGET(Jumanji.UI.view),       TRUE,  TRUE, 0);
+  gtk_box_pack_start(Jumanji.UI.box, GTK_WIDGET(Jumanji.UI.statusbar), FALSE, FALSE, 0);
+  gtk_box_pack_end(  Jumanji.UI.box, GTK_WIDGET(Jumanji.UI.inputbar),  FALSE, FALSE, 0);
 
-            rows = realloc(rows, (n_items + 1) * sizeof(CompletionRow));
-            rows[n_items].command     = element->value;
-            rows[n_items].description = element->description;
-            rows[n_items].command_id  = previous_id;
-            rows[n_items].is_group    = FALSE;
-            rows[n_items++].row       = GTK_WIDGET(create_completion_row(results, element->value, element->description, FALSE));
-            group_elements++;
-          }
-        }
-      }
+  Jumanji.Global.init_ui = TRUE;
+}
 
-      /* clean up */
-      completion_free(result);
+void notify(int level, char* message)
+{
+  if(!Jumanji.Global.init_ui)
+  {
+    if(message)
+    {
+      /* print error message to stdout while the ui has not been loaded */
+      char* dmessage = g_strconcat("jumanjirc: ", message, NULL);
+      printf("%s\n", dmessage);
+      g_free(dmessage);
     }
-    /* create list based on commands */
-    else
+
+    return;
+  }
+
+  /* while running a batch only the most severe message is kept */
+  if(Jumanji.Batch.depth)
+  {
+    if(message && strlen(message) > 0 && (!Jumanji.Batch.notify_message
+          || level == ERROR || (level == WARNING && Jumanji.Batch.notify_level != ERROR)
+          || (level == DEFAULT && Jumanji.Batch.notify_level == DEFAULT)))
     {
-      command_mode = TRUE;
+      g_free(Jumanji.Batch.notify_message);
+      Jumanji.Batch.notify_message = g_strdup(message);
+      Jumanji.Batch.notify_level   = level;
+    }
 
-      rows = malloc(LENGTH(commands) * sizeof(CompletionRow));
-      if(!rows)
-        out_of_memory();
+    return;
+  }
 
-      for(unsigned int i = 0; i < LENGTH(commands); i++)
+  if(!message || strlen(message) <= 0)
+  {
+    gtk_widget_hide(GTK_WIDGET(Jumanji.UI.inputbar));
+    return;
+  }
+
+  if(!(GTK_WIDGET_VISIBLE(GTK_WIDGET(Jumanji.UI.inputbar))))
+    gtk_widget_show(GTK_WIDGET(Jumanji.UI.inputbar));
+
+  switch(level)
+  {
+    case ERROR:
+      set_style(GTK_WIDGET(Jumanji.UI.inputbar), "jumanji-inputbar-error");
+      break;
+    case WARNING:
+      set_style(GTK_WIDGET(Jumanji.UI.inputbar), "jumanji-inputbar-warning");
+      break;
+    default:
+      set_style(GTK_WIDGET(Jumanji.UI.inputbar), "jumanji-inputbar");
+      break;
+  }
+
+  if(message)
+    gtk_entry_set_text(Jumanji.UI.inputbar, message);
+}
+
+void
+init_jumanji()
+{
+  /* other */
+  Jumanji.Global.mode                = NORMAL;
+  Jumanji.Global.count               = 0;
+  Jumanji.Global.search_engines      = NULL;
+  Jumanji.Global.command_history     = NULL;
+  Jumanji.Global.scripts             = NULL;
+  Jumanji.Global.script_generation   = 1;
+  Jumanji.Global.bridge              = NULL;
+  Jumanji.Global.markers             = NULL;
+  Jumanji.Global.bookmarks           = NULL;
+  Jumanji.Global.history             = NULL;
+  Jumanji.Global.last_closed         = NULL;
+  Jumanji.Global.init_ui             = FALSE;
+  Jumanji.Batch.depth                = 0;
+  Jumanji.Global.profiles           = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, free_script_profile);
+  Jumanji.Tabs.list                  = g_ptr_array_new();
+  Jumanji.Tabs.ids                   = g_hash_table_new(g_direct_hash, g_direct_equal);
+  Jumanji.Tabs.current               = NULL;
+  Jumanji.Tabs.next_id               = 0;
+  Jumanji.Tabs.slots                 = NULL;
+  Jumanji.Tabs.n_slots               = 0;
+  Jumanji.Hints.tab                  = NULL;
+  Jumanji.Hints.engine               = NULL;
+  Jumanji.Hints.list                 = NULL;
+  Jumanji.Hints.texts                = NULL;
+  Jumanji.Hints.filter               = NULL;
+  Jumanji.Hints.rescan_id            = 0;
+  Jumanji.Hiding.rules               = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_ptr_array_unref);
+  Jumanji.Hiding.sheets              = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+  Jumanji.Blocker.lists              = g_ptr_array_new_with_free_func(g_free);
+  Jumanji.Blocker.filter             = NULL;
+  Jumanji.Blocker.building           = FALSE;
+  Jumanji.Blocker.pending            = FALSE;
+  Jumanji.Blocker.build_id           = 0;
+  Jumanji.Blocker.blocked            = 0;
+  Jumanji.Collector.idle_id          = 0;
+  Jumanji.Collector.passes           = 0;
+  Jumanji.Collector.collections      = 0;
+  Jumanji.Collector.skip             = 0;
+  Jumanji.Collector.rss_change       = 0;
+  Jumanji.Statusbar.dirty            = 0;
+  Jumanji.Statusbar.dirty_tabs       = NULL;
+  Jumanji.Statusbar.throttled        = 0;
+  Jumanji.Statusbar.throttle_id      = 0;
+  Jumanji.Statusbar.link             = NULL;
+  Jumanji.Statusbar.flush_id         = 0;
+  Jumanji.Batch.notify_message       = NULL;
+  Jumanji.Bindings.sclist            = NULL;
+  Jumanji.Bindings.bcmdlist          = NULL;
+
+  /* webkit settings */
+  Jumanji.Global.browser_settings = webkit_web_settings_new();
+
+  /* GDK keymap */
+  Jumanji.Global.keymap = gdk_keymap_get_default();
+
+  /* speculation */
+  Jumanji.Speculation.hosts      = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  Jumanji.Speculation.hovered    = NULL;
+  Jumanji.Speculation.prefetched = NULL;
+  Jumanji.Speculation.hover_id   = 0;
+  Jumanji.Speculation.pending    = 0;
+
+  /* cookies */
+  Jumanji.Cookies.jar      = NULL;
+  Jumanji.Cookies.domains  = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  Jumanji.Cookies.dirty    = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+  Jumanji.Cookies.loading  = FALSE;
+  Jumanji.Cookies.flush_id = 0;
+  Jumanji.Cookies.thread   = NULL;
+
+  /* libsoup session */
+  Jumanji.Soup.session     = webkit_get_default_session();
+  Jumanji.Soup.cache       = NULL;
+  Jumanji.Soup.requests    = 0;
+  Jumanji.Soup.network     = 0;
+  Jumanji.Soup.revalidated = 0;
+
+  g_signal_connect(G_OBJECT(Jumanji.Soup.session), "request-queued",  G_CALLBACK(cb_soup_request_queued),  NULL);
+  g_signal_connect(G_OBJECT(Jumanji.Soup.session), "request-started", G_CALLBACK(cb_soup_request_started), NULL);
+}
+
+void
+new_window(char* uri)
+{
+  if(!uri)
+    return;
+
+  char* nargv[6];
+  if(Jumanji.UI.embed)
+  {
+    nargv[0] = *(Jumanji.Global.arguments);
+    nargv[1] = "-e";
+    nargv[2] = Jumanji.UI.winid;
+    nargv[3] = uri;
+    nargv[4] = NULL;
+  }
+  else
+  {
+    nargv[0] = *(Jumanji.Global.arguments);
+    nargv[1] = uri;
+    nargv[2] = NULL;
+  }
+
+  g_spawn_async(NULL, nargv, NULL, G_SPAWN_SEARCH_PATH, NULL, NULL, NULL, NULL);
+}
+
+void
+out_of_memory()
+{
+  printf("error: out of memory\n");
+  exit(-1);
+}
+
+void
+open_uri(WebKitWebView* web_view, char* uri)
+{
+  if(!uri)
+    return;
+
+  while (*uri == ' ')
+    uri++;
+
+  gchar* new_uri = NULL;
+
+  /* multiple argument given */
+  char* uri_first_space = strchr(uri, ' ');
+  if(uri_first_space)
+  {
+    unsigned int first_arg_length = uri_first_space - uri;
+
+    SearchEngineList* se = Jumanji.Global.search_engines;
+    while(se)
+    {
+      if(strlen(se->name) == first_arg_length && !strncmp(uri, se->name, first_arg_length))
+        break;
+
+      se = se->next;
+    }
+    /* first agrument contain "://"
+     * -> it's a bookmark with tag
+     */
+    if(!se && strstr(uri, "://"))
+    {
+      new_uri = g_strndup(uri, first_arg_length);
+    }
+    /* first agrument doesn't contain "://"
+     * -> use search engine
+     */
+    else
+    {
+      if(!se)
+        se = Jumanji.Global.search_engines;
+      else /* we remove the trailing arg since it's the se name */
+        uri = uri + first_arg_length + 1;
+
+      if(se)
       {
-        int abbr_length = commands[i].abbr ? strlen(commands[i].abbr) : 0;
-        int cmd_length  = commands[i].command ? strlen(commands[i].command) : 0;
+        /* there is at lease 1 search search engine */
+        new_uri = g_strdup_printf(se->uri, uri);
 
-        /* add command to list iff
-         *  the current command would match the command
-         *  the current command would match the abbreviation
+        /* we change all the space with '+'
+         * -2 for the '%s'
          */
-        if( ((current_command_length <= cmd_length)  && !strncmp(current_command, commands[i].command, current_command_length)) ||
-            ((current_command_length <= abbr_length) && !strncmp(current_command, commands[i].abbr,    current_command_length))
-          )
+        char* new_uri_it = new_uri + strlen(se->uri) - 2;
+
+        while(*new_uri_it)
         {
-          rows[n_items].command     = commands[i].command;
-          rows[n_items].description = commands[i].description;
-          rows[n_items].command_id  = i;
-          rows[n_items].is_group    = FALSE;
-          rows[n_items++].row       = GTK_WIDGET(create_completion_row(results, commands[i].command, commands[i].description, FALSE));
+          if(*new_uri_it == ' ')
+            *new_uri_it = '+';
+
+          new_uri_it++;
+        }
+      }
+      else
+      {
+        /* there is 0 search engine (a very rare case...) */
+        new_uri = g_strconcat("http://", uri, NULL);
+
+        char* nu_first_space;
+
+        /* we fill ' ' with '%20' */
+        while ((nu_first_space = strchr(new_uri, ' ')))
+        {
+          /* we break new_uri at the first ' ' */
+          *nu_first_space = '\0';
+          char* nu_first_part = new_uri;
+          char* nu_second_part = nu_first_space + 1;
+
+          new_uri = g_strconcat(nu_first_part, "%20", nu_second_part, NULL);
+
+          g_free(nu_first_part);
         }
       }
+    }
+  }
+  /* no argument given */
+  else if(strlen(uri) == 0)
+  {
+    new_uri = g_strdup(home_page);
+  }
+  /* only one argument given */
+  else
+  {
+    /* uri reformating to get new_uri match
+     * ^http://.*$
+     * or
+     * ^file://.*$
+     */
+
+    /* file path */
+    if(uri[0] == '/' || strncmp(uri, "./", 2) == 0)
+    {
+      new_uri = g_strconcat("file://", uri, NULL);
+    }
+    /* uri does contain any ".", ":" or "/"
+     * nor it start with "localhost"
+     * -> default searchengine
+     */
+    else if(!strpbrk(uri, ".:/") && strncmp(uri, "localhost", 9))
+    {
+      if(Jumanji.Global.search_engines)
+      {
+        new_uri = g_strdup_printf(Jumanji.Global.search_engines->uri, uri);
+
+        /* -2 for the '%s' */
+        gchar* searchitem = new_uri + strlen(Jumanji.Global.search_engines->uri) - 2;
+
+        while(*searchitem)
+        {
+          if(*searchitem == ' ')
+            *searchitem = '+';
+
+          searchitem += 1;
+        }
+      }
+      else
+        new_uri = g_strconcat("http://", uri, NULL);
+    }
+    else
+      new_uri = strstr(uri, "://") ? g_strdup(uri) : g_strconcat("http://", uri, NULL);
+  }
+
+  webkit_web_view_load_uri(web_view, new_uri);
+
+  /* update history */
+  if(!private_browsing)
+  {
+    /* we verify if the new_uri is already present in the list*/
+    GList* l = g_list_find_custom(Jumanji.Global.history, new_uri, (GCompareFunc)strcmp);
+    if (l)
+    {
+      /* new_uri is already present : new move it to the end of the list */
+      Jumanji.Global.history = g_list_remove_link(Jumanji.Global.history, l);
+      Jumanji.Global.history = g_list_concat(l, Jumanji.Global.history);
+    }
+    else
+    {
+      Jumanji.Global.history = g_list_prepend(Jumanji.Global.history, g_strdup(new_uri));
+    }
+  }
+
+  g_free(new_uri);
+
+  update_status();
+}
+
+gchar**
+parse_line(char* line, int* length)
+{
+  *length = 0;
+
+  if(!line || !strlen(line) || line[0] == '#')
+    return NULL;
+
+  gchar **pre_tokens = g_strsplit_set(line, "\t ", -1);
+  int     pre_length = g_strv_length(pre_tokens);
+
+  /* the tokens are not freed since commands keep references to them */
+  gchar** tokens = g_malloc0(sizeof(gchar*) * (pre_length + 1));
+  gchar** tokp   = tokens;
+  for(int i = 0; i != pre_length; ++i)
+  {
+    if(strlen(pre_tokens[i]))
+    {
+      *tokp++ = pre_tokens[i];
+      ++(*length);
+    }
+  }
+
+  g_free(pre_tokens);
+
+  if(!*length)
+  {
+    g_free(tokens);
+    return NULL;
+  }
+
+  return tokens;
+}
+
+void
+update_status()
+{
+  mark_dirty(DIRTY_ALL);
+}
+
+void
+json_append_date(GString* output, gint64 time)
+{
+  GTimeVal value = { time / G_USEC_PER_SEC, time % G_USEC_PER_SEC };
+  char*    date  = g_time_val_to_iso8601(&value);
+
+  json_append_string(output, date);
+  g_free(date);
+}
+
+void
+json_append_number(GString* output, const char* name, double value)
+{
+  /* the decimal separator of the locale is not valid json */
+  char buffer[G_ASCII_DTOSTR_BUF_SIZE];
+  g_string_append_printf(output, "\"%s\":%s", name, g_ascii_formatd(buffer, sizeof(buffer), "%.3f", value));
+}
+
+void
+json_append_string(GString* output, const char* string)
+{
+  g_string_append_c(output, '"');
+
+  for(const char* c = string ? string : ""; *c; c++)
+  {
+    if(*c == '"' || *c == '\\')
+      g_string_append_printf(output, "\\%c", *c);
+    else if((unsigned char) *c < 0x20)
+      g_string_append_printf(output, "\\u%04x", (unsigned char) *c);
+    else
+      g_string_append_c(output, *c);
+  }
+
+  g_string_append_c(output, '"');
+}
+
+void
+mark_dirty(int flags)
+{
+  Jumanji.Statusbar.dirty |= flags;
+
+  /* everything is redrawn at once when the main loop becomes idle or when
+   * the running batch has finished */
+  if(Jumanji.Statusbar.dirty && !Jumanji.Statusbar.flush_id && !Jumanji.Batch.depth)
+    Jumanji.Statusbar.flush_id = g_idle_add_full(G_PRIORITY_HIGH_IDLE, flush_status, NULL, NULL);
+}
+
+void
+mark_dirty_throttled(int flags)
+{
+  if(status_interval <= 0)
+  {
+    mark_dirty(flags);
+    return;
+  }
+
+  /* the first update is drawn immediately, the following ones are collected
+   * and drawn at most once per interval */
+  if(Jumanji.Statusbar.throttle_id)
+  {
+    Jumanji.Statusbar.throttled |= flags;
+    return;
+  }
+
+  mark_dirty(flags);
+  Jumanji.Statusbar.throttle_id = g_timeout_add(status_interval, cb_status_throttle, NULL);
+}
+
+void
+mark_tab_dirty(Tab* tab)
+{
+  queue_tab_label(tab);
+  mark_dirty(DIRTY_LABELS);
+}
+
+void
+queue_tab_label(Tab* tab)
+{
+  if(tab->label_queued)
+    return;
+
+  tab->label_queued = TRUE;
+  Jumanji.Statusbar.dirty_tabs = g_list_prepend(Jumanji.Statusbar.dirty_tabs, tab);
+}
+
+gboolean
+flush_status(gpointer UNUSED(data))
+{
+  int    dirty      = Jumanji.Statusbar.dirty;
+  GList* dirty_tabs = Jumanji.Statusbar.dirty_tabs;
+
+  Jumanji.Statusbar.dirty      = 0;
+  Jumanji.Statusbar.dirty_tabs = NULL;
+  Jumanji.Statusbar.flush_id   = 0;
+
+  for(GList* list = dirty_tabs; list; list = g_list_next(list))
+    ((Tab*) list->data)->label_queued = FALSE;
+
+  if(!Jumanji.Tabs.current)
+  {
+    g_list_free(dirty_tabs);
+    return FALSE;
+  }
+
+  /* a hovered link replaces the uri until the uri or the progress changes */
+  if(dirty & DIRTY_URI)
+    update_uri();
+  else if((dirty & DIRTY_LINK) && Jumanji.Statusbar.link)
+  {
+    gchar* link = g_strconcat("Link: ", Jumanji.Statusbar.link, NULL);
+    gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.text, link);
+    g_free(link);
+  }
+  else if(dirty & DIRTY_LINK)
+    update_uri();
+
+  /* update title */
+  if(dirty & DIRTY_TITLE)
+  {
+    const gchar* title = webkit_web_view_get_title(GET_CURRENT_TAB());
+    if(title)
+      gtk_window_set_title(GTK_WINDOW(Jumanji.UI.window), title);
+    else
+      gtk_window_set_title(GTK_WINDOW(Jumanji.UI.window), "jumanji");
+  }
+
+  /* update tab position */
+  int current_tab     = Jumanji.Tabs.current->position;
+  int number_of_tabs  = Jumanji.Tabs.list->len;
+
+  if(dirty & DIRTY_TABS)
+  {
+    gchar* tabs = g_strdup_printf("[%d/%d]", current_tab + 1, number_of_tabs);
+    gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.tabs, tabs);
+    g_free(tabs);
+  }
+
+  /* update tabbar, either every tab whose number or focus might have changed
+   * or only the tabs whose title changed */
+  if(dirty & DIRTY_TABBAR)
+  {
+    /* move the visible part of the tabbar so that the current tab is shown */
+    if(current_tab < Jumanji.Tabs.first)
+      Jumanji.Tabs.first = current_tab;
+    else if(current_tab >= Jumanji.Tabs.first + Jumanji.Tabs.n_slots)
+      Jumanji.Tabs.first = current_tab - Jumanji.Tabs.n_slots + 1;
+
+    if(Jumanji.Tabs.first > number_of_tabs - Jumanji.Tabs.n_slots)
+      Jumanji.Tabs.first = MAX(0, number_of_tabs - Jumanji.Tabs.n_slots);
+
+    for(int i = 0; i < Jumanji.Tabs.n_slots; i++)
+    {
+      int tc = Jumanji.Tabs.first + i;
+      update_tab_slot(&(Jumanji.Tabs.slots[i]), (tc < number_of_tabs) ? GET_TAB(tc) : NULL, tc == current_tab);
+    }
+
+    /* number of hidden tabs on both sides */
+    int hidden_right = number_of_tabs - Jumanji.Tabs.first - Jumanji.Tabs.n_slots;
+
+    if(Jumanji.Tabs.first > 0)
+    {
+      gchar* left = g_strdup_printf("<%d", Jumanji.Tabs.first);
+      gtk_label_set_text(GTK_LABEL(Jumanji.Tabs.left), left);
+      gtk_widget_show(gtk_widget_get_parent(Jumanji.Tabs.left));
+      g_free(left);
+    }
+    else
+      gtk_widget_hide(gtk_widget_get_parent(Jumanji.Tabs.left));
+
+    if(hidden_right > 0)
+    {
+      gchar* right = g_strdup_printf("%d>", hidden_right);
+      gtk_label_set_text(GTK_LABEL(Jumanji.Tabs.right), right);
+      gtk_widget_show(gtk_widget_get_parent(Jumanji.Tabs.right));
+      g_free(right);
+    }
+    else
+      gtk_widget_hide(gtk_widget_get_parent(Jumanji.Tabs.right));
+  }
+  else
+  {
+    for(GList* list = dirty_tabs; list; list = g_list_next(list))
+      update_tab_label((Tab*) list->data, list->data == Jumanji.Tabs.current);
+  }
+
+  g_list_free(dirty_tabs);
+
+  if(dirty & DIRTY_POSITION)
+    update_position();
+
+  return FALSE;
+}
+
+void
+update_tab_label(Tab* tab, gboolean focus)
+{
+  /* only tabs in the visible part of the tabbar have a label */
+  int slot = tab->position - Jumanji.Tabs.first;
+
+  if(slot >= 0 && slot < Jumanji.Tabs.n_slots && Jumanji.Tabs.slots[slot].tab == tab)
+    update_tab_slot(&(Jumanji.Tabs.slots[slot]), tab, focus);
+}
+
+void
+update_tab_slot(TabSlot* slot, Tab* tab, gboolean focus)
+{
+  if(!tab)
+  {
+    if(slot->tab || GTK_WIDGET_VISIBLE(slot->event_box))
+      gtk_widget_hide(slot->event_box);
+
+    slot->tab = NULL;
+    return;
+  }
+
+  if(!GTK_WIDGET_VISIBLE(slot->event_box))
+    gtk_widget_show(slot->event_box);
+
+  slot->tab = tab;
+
+  /* the last drawn state is stored in the slot, only changes are drawn;
+   * focus and number are stored increased by one so that 0 means never
+   * drawn */
+  if(slot->focus != focus + 1)
+  {
+    set_style(slot->event_box, focus ? "jumanji-tab-focus" : "jumanji-tab");
+    slot->focus = focus + 1;
+  }
+
+  const gchar* tab_title = webkit_web_view_get_title(tab->view);
+  int progress = webkit_web_view_get_progress(tab->view) * 100;
+  const gchar* text = tab_title ? tab_title : ((progress == 100) ? "Loading..." : "(Untitled)");
+
+  if(slot->number == tab->position + 1 && !g_strcmp0(slot->text, text))
+    return;
+
+  gchar* n_tab_title = g_strdup_printf("%d | %s", tab->position + 1, text);
+  gtk_label_set_text((GtkLabel*) slot->label, n_tab_title);
+  g_free(n_tab_title);
+
+  slot->number = tab->position + 1;
+  g_free(slot->text);
+  slot->text = g_strdup(text);
+}
+
+void
+update_uri()
+{
+  gchar* link  = (gchar*) webkit_web_view_get_uri(GET_CURRENT_TAB());
+  int progress = webkit_web_view_get_progress(GET_CURRENT_TAB()) * 100;
+  gchar* uri   = (progress != 100 && progress != 0) ? g_strdup_printf("Loading... %s (%d%%)", link ? link : "", progress) :
+                 (link ? g_strdup(link) : NULL);
+
+  /* check for https */
+  gboolean ssl = link ? g_str_has_prefix(link, "https://") : FALSE;
+  set_style(GTK_WIDGET(Jumanji.UI.statusbar), ssl ? "jumanji-statusbar-ssl" : "jumanji-statusbar");
+
+  /* check for possible navigation */
+  if(!uri)
+    uri = g_strdup("[No name]");
+  else
+  {
+    GString* navigation = g_string_new("");
+
+    if(webkit_web_view_can_go_back(GET_CURRENT_TAB()))
+      g_string_append_c(navigation, '+');
+    if(webkit_web_view_can_go_forward(GET_CURRENT_TAB()))
+      g_string_append_c(navigation, '-');
+
+    if(navigation->len > 0)
+    {
+      char* new_uri = g_strconcat(uri, " [", navigation->str, "]", NULL);
+      g_free(uri);
+      uri = new_uri;
+    }
+
+    g_string_free(navigation, TRUE);
+  }
+
+  /* check for offline mode */
+  if(offline || Jumanji.Tabs.current->offline)
+  {
+    char* new_uri = g_strconcat(uri, " [offline]", NULL);
+    g_free(uri);
+    uri = new_uri;
+  }
+
+  gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.text, uri);
+  g_free(uri);
+}
+
+void
+update_position()
+{
+  if (!Jumanji.Tabs.current)
+    return;
+
+  GtkAdjustment* adjustment = gtk_scrolled_window_get_vadjustment(GET_CURRENT_TAB_WIDGET());
+  gdouble view_size         = gtk_adjustment_get_page_size(adjustment);
+  gdouble value             = gtk_adjustment_get_value(adjustment);
+  gdouble max               = gtk_adjustment_get_upper(adjustment) - view_size;
+
+  gchar* position;
+  if(max == 0)
+    position = g_strdup("All");
+  else if(value == max)
+    position = g_strdup("Bot");
+  else if(value == 0)
+    position = g_strdup("Top");
+  else
+    position = g_strdup_printf("%2d%%", (int) ceil(((value / max) * 100)));
+
+  gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.position, position);
+  g_free(position);
+}
+
+void
+read_configuration()
+{
+  char* jumanjirc = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_RC, NULL);
+
+  if(!jumanjirc)
+    return;
+
+  if(g_file_test(jumanjirc, G_FILE_TEST_IS_REGULAR))
+  {
+    char* content = NULL;
+
+    if(g_file_get_contents(jumanjirc, &content, NULL, NULL))
+    {
+      gchar **lines = g_strsplit(content, "\n", -1);
+      int     n     = g_strv_length(lines) - 1;
+
+      batch_begin();
+
+      int i;
+      for(i = 0; i <= n; i++)
+      {
+        int     length = 0;
+        gchar** tokens = parse_line(lines[i], &length);
+
+        if(!tokens)
+          continue;
+
+        if(!strcmp(tokens[0], "set"))
+          cmd_set(length - 1, tokens + 1);
+        else if(!strcmp(tokens[0], "map"))
+          cmd_map(length - 1, tokens + 1);
+        else if(!strcmp(tokens[0], "bmap"))
+          cmd_bmap(length - 1, tokens + 1);
+        else if(!strcmp(tokens[0], "searchengine"))
+          cmd_search_engine(length - 1, tokens + 1);
+        else if(!strcmp(tokens[0], "script"))
+          cmd_script(length - 1, tokens + 1);
+
+        g_free(tokens);
+      }
+
+      batch_end();
+    }
+  }
+
+  g_free(jumanjirc);
+}
+
+char*
+read_file(const char* path)
+{
+  char* content = NULL;
+
+  /* specify path max */
+  size_t pm;
+#ifdef PATH_MAX
+  pm = PATH_MAX;
+#else
+  pm = pathconf(path,_PC_PATH_MAX);
+  if(pm <= 0)
+    pm = 4096;
+#endif
+
+  /* get filename */
+  char* npath;
+
+  if(path[0] == '~')
+    npath = g_build_filename(g_get_home_dir(), path + 1, NULL);
+  else
+    npath = g_strdup(path);
+
+  char* file = (char*) calloc(sizeof(char), pm);
+  if(!file || !realpath(npath, file))
+  {
+    if(file)
+      free(file);
+    g_free(npath);
+    return NULL;
+  }
+
+  g_free(npath);
+
+  /* check if file exists */
+  if(g_file_test(file, G_FILE_TEST_IS_REGULAR))
+    if(g_file_get_contents(file, &content, NULL, NULL))
+      return content;
+
+  return NULL;
+}
+
+void
+record_command(const char* command)
+{
+  if(!Jumanji.Replay.record || Jumanji.Replay.events)
+    return;
+
+  fprintf(Jumanji.Replay.record, "%.3f cmd %s\n",
+      g_timer_elapsed(Jumanji.Replay.timer, NULL) * 1000, command);
+  fflush(Jumanji.Replay.record);
+}
+
+void
+record_request(Tab* tab, WebKitWebView* wv, WebKitWebFrame* frame, WebKitNetworkRequest* request,
+    WebKitNetworkResponse* response)
+{
+  SoupMessage* message = webkit_network_request_get_message(request);
+
+  if(!tab || !message)
+    return;
+
+  /* the main resource of a new page starts a new log, redirects continue it */
+  WebKitWebDataSource* source = webkit_web_frame_get_provisional_data_source(frame);
+  gboolean page = !response && source && frame == webkit_web_view_get_main_frame(wv) &&
+    !strcmp(webkit_network_request_get_uri(webkit_web_data_source_get_request(source)),
+        webkit_network_request_get_uri(request));
+
+  if(page || !tab->requests)
+  {
+    if(tab->requests)
+      g_ptr_array_free(tab->requests, TRUE);
+    tab->requests = g_ptr_array_new_with_free_func(free_request_timing);
+  }
+
+  if(tab->requests->len >= REQUEST_LOG_LIMIT || g_object_get_data(G_OBJECT(message), TIMING_DATA))
+    return;
+
+  RequestTiming* timing = g_malloc0(sizeof(RequestTiming));
+  timing->message     = message;
+  timing->method      = g_strdup(message->method);
+  timing->uri         = g_strdup(webkit_network_request_get_uri(request));
+  timing->started     = g_get_real_time();
+  timing->queued      = g_get_monotonic_time();
+  timing->resolving   = timing->resolved  = timing->connecting = -1;
+  timing->handshaking = timing->connected = timing->sent       = -1;
+  timing->wrote       = timing->headers   = timing->body       = timing->finished = -1;
+
+  /* the message is not referenced, the pointer is cleared when it goes away */
+  g_ptr_array_add(tab->requests, timing);
+  g_object_set_data(G_OBJECT(message), TIMING_DATA, timing);
+  g_object_add_weak_pointer(G_OBJECT(message), (gpointer*) &timing->message);
+
+  g_signal_connect(G_OBJECT(message), "network-event", G_CALLBACK(cb_soup_network_event), NULL);
+  g_signal_connect(G_OBJECT(message), "wrote-body",    G_CALLBACK(cb_soup_timing),
+      GINT_TO_POINTER(G_STRUCT_OFFSET(RequestTiming, wrote)));
+  g_signal_connect(G_OBJECT(message), "got-headers",   G_CALLBACK(cb_soup_timing),
+      GINT_TO_POINTER(G_STRUCT_OFFSET(RequestTiming, headers)));
+  g_signal_connect(G_OBJECT(message), "got-chunk",     G_CALLBACK(cb_soup_got_chunk), NULL);
+  g_signal_connect(G_OBJECT(message), "got-body",      G_CALLBACK(cb_soup_timing),
+      GINT_TO_POINTER(G_STRUCT_OFFSET(RequestTiming, body)));
+  g_signal_connect(G_OBJECT(message), "finished",      G_CALLBACK(cb_soup_timing_finished), NULL);
+}
+
+void
+record_key(GdkEventKey* event)
+{
+  if(!Jumanji.Replay.record || Jumanji.Replay.events)
+    return;
+
+  fprintf(Jumanji.Replay.record, "%.3f key %u %u %u %u\n",
+      g_timer_elapsed(Jumanji.Replay.timer, NULL) * 1000,
+      event->state, event->keyval, event->hardware_keycode, event->group);
+  fflush(Jumanji.Replay.record);
+}
+
+gint64
+resident_memory()
+{
+  /* the second field of statm is the resident set size in pages */
+  char* statm = NULL;
+  long  pages = 0;
+
+  if(!g_file_get_contents("/proc/self/statm", &statm, NULL, NULL))
+    return 0;
+
+  if(sscanf(statm, "%*s %ld", &pages) != 1)
+    pages = 0;
+
+  g_free(statm);
+
+  return (gint64) pages * sysconf(_SC_PAGESIZE);
+}
+
+char*
+reference_to_string(JSContextRef context, JSValueRef reference)
+{
+  if(!context || !reference)
+    return NULL;
+
+  JSStringRef ref_st = JSValueToStringCopy(context, reference, NULL);
+  size_t      length = JSStringGetMaximumUTF8CStringSize(ref_st);
+  gchar*      string = g_new(gchar, length);
+  JSStringGetUTF8CString(ref_st, string, length);
+  JSStringRelease(ref_st);
+
+  return string;
+}
+
+gboolean
+run_command(char* line)
+{
+  int     length = 0;
+  gchar** tokens = parse_line(line, &length);
+
+  if(!tokens)
+    return TRUE;
+
+  gboolean retv = FALSE;
+  gboolean succ = FALSE;
+
+  for(unsigned int i = 0; i < LENGTH(commands); i++)
+  {
+    if((g_strcmp0(tokens[0], commands[i].command) == 0) ||
+       (g_strcmp0(tokens[0], commands[i].abbr)    == 0))
+    {
+      retv = commands[i].function(length - 1, tokens + 1);
+      succ = TRUE;
+      break;
+    }
+  }
+
+  if(!succ)
+  {
+    gchar* message = g_strdup_printf("Unknown command '%s'", tokens[0]);
+    notify(ERROR, message);
+    g_free(message);
+  }
+
+  g_free(tokens);
+
+  return retv;
+}
+
+void
+run_script(char* script, const char* caller, char** value, char** error)
+{
+  if(!script)
+    return;
+
+  WebKitWebFrame *frame = webkit_web_view_get_main_frame(GET_CURRENT_TAB());
+
+  if(!frame)
+    return;
+
+  JSContextRef context  = webkit_web_frame_get_global_context(frame);
+  JSStringRef sc        = JSStringCreateWithUTF8CString(script);
+
+  if(!context || !sc)
+    return;
+
+  JSValueRef exception = NULL;
+  JSValueRef va   = evaluate_script(context, sc, script, caller, &exception);
+  JSStringRelease(sc);
+
+  if(!va && error)
+    *error = reference_to_string(context, exception);
+  else if(value)
+    *value = reference_to_string(context, va);
+}
+
+gboolean
+replay_start(char* path)
+{
+  char* content = read_file(path);
+
+  if(!content)
+  {
+    fprintf(stderr, "jumanji: could not read replay file '%s'\n", path);
+    return FALSE;
+  }
+
+  Jumanji.Replay.events  = g_strsplit(content, "\n", -1);
+  Jumanji.Replay.current = 0;
+  Jumanji.Replay.pending = -1;
+  Jumanji.Replay.total   = 0;
+
+  /* a recording started alongside shares the timer */
+  if(!Jumanji.Replay.timer)
+    Jumanji.Replay.timer = g_timer_new();
+  g_free(content);
+
+  /* the events are replayed as fast as possible, the next one is sent as soon
+   * as the previous one has been handled and no tab is loading anymore */
+  g_timeout_add_full(G_PRIORITY_LOW, replay_interval, replay_step, NULL, NULL);
+
+  return TRUE;
+}
+
+gboolean
+replay_step(gpointer UNUSED(data))
+{
+  /* wait until all tabs have finished loading */
+  int number_of_tabs = (int) Jumanji.Tabs.list->len;
+  for(int i = 0; i < number_of_tabs; i++)
+  {
+    WebKitLoadStatus status = webkit_web_view_get_load_status(GET_NTH_TAB(i));
+    if(status != WEBKIT_LOAD_FINISHED && status != WEBKIT_LOAD_FAILED)
+      return TRUE;
+  }
+
+  double now = g_timer_elapsed(Jumanji.Replay.timer, NULL);
+
+  if(Jumanji.Replay.pending >= 0)
+  {
+    double latency = now - Jumanji.Replay.started;
+    Jumanji.Replay.total += latency;
+
+    printf("%5d %10.3f ms  %s\n", Jumanji.Replay.pending + 1, latency * 1000,
+        Jumanji.Replay.events[Jumanji.Replay.pending]);
+    Jumanji.Replay.pending = -1;
+  }
+
+  /* find next event */
+  char*  line  = NULL;
+  double stamp = 0;
+  int    start = 0;
+  char   type[4];
+
+  for(; Jumanji.Replay.events[Jumanji.Replay.current]; Jumanji.Replay.current++)
+  {
+    line = Jumanji.Replay.events[Jumanji.Replay.current];
+
+    if(sscanf(line, "%lf %3s %n", &stamp, type, &start) == 2)
+      break;
+  }
+
+  if(!Jumanji.Replay.events[Jumanji.Replay.current])
+  {
+    printf("total %10.3f ms (wall %10.3f ms)\n", Jumanji.Replay.total * 1000, now * 1000);
+
+    g_strfreev(Jumanji.Replay.events);
+    Jumanji.Replay.events = NULL;
+    if(!Jumanji.Replay.record)
+    {
+      g_timer_destroy(Jumanji.Replay.timer);
+      Jumanji.Replay.timer = NULL;
+    }
+
+    gtk_widget_destroy(Jumanji.UI.window);
+    return FALSE;
+  }
+
+  Jumanji.Replay.pending = Jumanji.Replay.current++;
+  Jumanji.Replay.started = g_timer_elapsed(Jumanji.Replay.timer, NULL);
+
+  if(!strcmp(type, "key"))
+  {
+    unsigned int state, keyval, keycode, group;
+    if(sscanf(line + start, "%u %u %u %u", &state, &keyval, &keycode, &group) != 4)
+      return TRUE;
+
+    GtkWidget* tab = GTK_WIDGET(GET_CURRENT_TAB_WIDGET());
+
+    GdkEvent* event             = gdk_event_new(GDK_KEY_PRESS);
+    event->key.window           = g_object_ref(tab->window);
+    event->key.send_event       = TRUE;
+    event->key.time             = GDK_CURRENT_TIME;
+    event->key.state            = state;
+    event->key.keyval           = keyval;
+    event->key.hardware_keycode = keycode;
+    event->key.group            = group;
+
+    /* like live input the webview gets the key first, the tab only the
+     * keys it did not handle */
+    if(!gtk_widget_event(GTK_WIDGET(GET_CURRENT_TAB()), event))
+      cb_tab_kb_pressed(tab, &(event->key), NULL);
+
+    gdk_event_free(event);
+  }
+  else if(!strcmp(type, "cmd"))
+  {
+    gtk_entry_set_text(Jumanji.UI.inputbar, line + start);
+    cb_inputbar_activate(Jumanji.UI.inputbar, NULL);
+  }
+
+  return TRUE;
+}
+
+void
+set_completion_row_color(GtkBox* results, int mode, int id)
+{
+  GtkEventBox *row   = (GtkEventBox*) g_list_nth_data(gtk_container_get_children(GTK_CONTAINER(results)), id);
+
+  if(row)
+  {
+    set_style(GTK_WIDGET(row), (mode == NORMAL) ? "jumanji-completion" : "jumanji-completion-highlight");
+  }
+}
+
+void
+set_link(const char* link)
+{
+  g_free(Jumanji.Statusbar.link);
+  Jumanji.Statusbar.link = link ? g_strdup(link) : NULL;
+
+  mark_dirty_throttled(DIRTY_LINK);
+}
+
+void
+set_style(GtkWidget* widget, const char* name)
+{
+  if(!g_strcmp0(gtk_widget_get_name(widget), name))
+    return;
+
+  /* the style of the children depends on the name of the widget */
+  gtk_widget_set_name(widget, name);
+  gtk_widget_reset_rc_styles(widget);
+}
+
+gboolean
+standin_start(char* root)
+{
+  SoupAddress* address = soup_address_new("127.0.0.1", SOUP_ADDRESS_ANY_PORT);
+
+  Jumanji.Replay.root    = root;
+  Jumanji.Replay.standin = soup_server_new(SOUP_SERVER_INTERFACE, address, NULL);
+  g_object_unref(address);
+
+  if(!Jumanji.Replay.standin)
+  {
+    fprintf(stderr, "jumanji: could not start the local http server\n");
+    return FALSE;
+  }
+
+  soup_server_add_handler(Jumanji.Replay.standin, NULL, cb_standin_request, NULL, NULL);
+  soup_server_run_async(Jumanji.Replay.standin);
+
+  /* every http request is sent to the local server which acts as proxy */
+  char* uri = g_strdup_printf("http://127.0.0.1:%u/", soup_server_get_port(Jumanji.Replay.standin));
+  SoupURI* proxy_uri = soup_uri_new(uri);
+  g_object_set(Jumanji.Soup.session, "proxy-uri", proxy_uri, NULL);
+  soup_uri_free(proxy_uri);
+  g_free(uri);
+
+  return TRUE;
+}
+
+void
+speculate(const char* uri)
+{
+  if(!preconnect || offline || (Jumanji.Tabs.current && Jumanji.Tabs.current->offline) || !uri || strncmp(uri, "http", 4))
+    return;
+
+  SoupURI* soup_uri = soup_uri_new(uri);
+  if(!soup_uri || !soup_uri->host)
+  {
+    if(soup_uri)
+      soup_uri_free(soup_uri);
+    return;
+  }
+
+  /* domains the user opted out of */
+  gchar** domains = preconnect_exclude ? g_strsplit_set(preconnect_exclude, " ,", -1) : NULL;
+  gboolean excluded = FALSE;
+  size_t host_length = strlen(soup_uri->host);
+
+  for(int i = 0; domains && domains[i] && !excluded; i++)
+  {
+    size_t length = strlen(domains[i]);
+
+    if(length && length <= host_length && !strcmp(soup_uri->host + host_length - length, domains[i]) &&
+        (length == host_length || soup_uri->host[host_length - length - 1] == '.'))
+      excluded = TRUE;
+  }
+
+  g_strfreev(domains);
+
+  if(excluded || (Jumanji.Blocker.filter && blocker_match(Jumanji.Blocker.filter, uri)))
+  {
+    soup_uri_free(soup_uri);
+    return;
+  }
+
+  /* forget hosts whose connections have gone idle */
+  int now = g_get_monotonic_time() / G_USEC_PER_SEC;
+  GHashTableIter iter;
+  gpointer value;
+
+  g_hash_table_iter_init(&iter, Jumanji.Speculation.hosts);
+  while(g_hash_table_iter_next(&iter, NULL, &value))
+    if(now - GPOINTER_TO_INT(value) > PRECONNECT_LIFETIME)
+      g_hash_table_iter_remove(&iter);
+
+  /* resolve at most preconnect_max hosts at once, the connection itself is
+   * opened by the request */
+  if(!g_hash_table_lookup_extended(Jumanji.Speculation.hosts, soup_uri->host, NULL, NULL))
+  {
+    if((int) g_hash_table_size(Jumanji.Speculation.hosts) < preconnect_max)
+    {
+      g_hash_table_insert(Jumanji.Speculation.hosts, g_strdup(soup_uri->host), GINT_TO_POINTER(now));
+      soup_session_prefetch_dns(Jumanji.Soup.session, soup_uri->host, NULL, NULL, NULL);
+    }
+  }
+
+  soup_uri_free(soup_uri);
+
+  /* fetch the document into the cache */
+  if(!prefetch || Jumanji.Speculation.pending >= preconnect_max ||
+      (Jumanji.Speculation.prefetched && !strcmp(Jumanji.Speculation.prefetched, uri)))
+    return;
+
+  SoupMessage* message = soup_message_new(SOUP_METHOD_GET, uri);
+  if(!message)
+    return;
+
+  /* prefetches are left out of the cache statistics */
+  soup_message_headers_append(message->request_headers, "X-Purpose", "preview");
+  g_object_set_data(G_OBJECT(message), PREFETCH_DATA, GINT_TO_POINTER(TRUE));
+
+  g_free(Jumanji.Speculation.prefetched);
+  Jumanji.Speculation.prefetched = g_strdup(uri);
+  Jumanji.Speculation.pending++;
+
+  soup_session_queue_message(Jumanji.Soup.session, message, cb_speculate_prefetched, NULL);
+}
+
+void
+switch_view(GtkWidget* UNUSED(widget))
+{
+  /*GtkWidget* child = gtk_bin_get_child(GTK_BIN(Jumanji.UI.viewport));*/
+  /*if(child)*/
+  /*{*/
+    /*g_object_ref(child);*/
+    /*gtk_container_remove(GTK_CONTAINER(Jumanji.UI.viewport), child);*/
+  /*}*/
+
+  /*gtk_container_add(GTK_CONTAINER(Jumanji.UI.viewport), GTK_WIDGET(widget));*/
+}
+
+double
+timing_span(gint64 from, gint64 to)
+{
+  /* in milliseconds, -1 if either end was not reached */
+  return (from < 0 || to < 0 || to < from) ? -1 : (to - from) / 1000.0;
+}
+
+guint32
+trie_child(GArray* trie, guint32 node, guint8 c)
+{
+  guint32 child = g_array_index(trie, TrieNode, node).child;
+
+  while(child && g_array_index(trie, TrieNode, child).c != c)
+    child = g_array_index(trie, TrieNode, child).sibling;
+
+  return child;
+}
+
+GtkEventBox*
+create_completion_row(GtkBox* results, char* command, char* description, gboolean group)
+{
+  GtkBox      *col = GTK_BOX(gtk_hbox_new(FALSE, 0));
+  GtkEventBox *row = GTK_EVENT_BOX(gtk_event_box_new());
+
+  GtkLabel *show_command     = GTK_LABEL(gtk_label_new(NULL));
+  GtkLabel *show_description = GTK_LABEL(gtk_label_new(NULL));
+
+  gtk_misc_set_alignment(GTK_MISC(show_command),     0.0, 0.0);
+  gtk_misc_set_alignment(GTK_MISC(show_description), 0.0, 0.0);
+
+  /*if(group)*/
+  /*{*/
+    /*gtk_misc_set_padding(GTK_MISC(show_command),     2.0, 4.0);*/
+    /*gtk_misc_set_padding(GTK_MISC(show_description), 2.0, 4.0);*/
+  /*}*/
+  /*else*/
+  /*{*/
+    gtk_misc_set_padding(GTK_MISC(show_command),     1.0, 1.0);
+    gtk_misc_set_padding(GTK_MISC(show_description), 1.0, 1.0);
+  /*}*/
+
+  gtk_label_set_use_markup(show_command,     TRUE);
+  gtk_label_set_use_markup(show_description, TRUE);
+
+  gtk_label_set_markup(show_command,     g_markup_printf_escaped(FORMAT_COMMAND,     command ? command : ""));
+  gtk_label_set_markup(show_description, g_markup_printf_escaped(FORMAT_DESCRIPTION, description ? description : ""));
+
+  gtk_widget_set_name(GTK_WIDGET(row), group ? "jumanji-completion-group" : "jumanji-completion");
+
+  gtk_box_pack_start(GTK_BOX(col), GTK_WIDGET(show_command),     TRUE,  TRUE,  2);
+  gtk_box_pack_start(GTK_BOX(col), GTK_WIDGET(show_description), FALSE, FALSE, 2);
+
+  gtk_container_add(GTK_CONTAINER(row), GTK_WIDGET(col));
+
+  gtk_box_pack_start(results, GTK_WIDGET(row), FALSE, FALSE, 0);
+  gtk_widget_show_all(GTK_WIDGET(row));
+
+  return row;
+}
+
+Completion*
+completion_init()
+{
+  Completion *completion = malloc(sizeof(Completion));
+  if(!completion)
+    out_of_memory();
+
+  completion->groups = NULL;
+
+  return completion;
+}
+
+CompletionGroup*
+completion_group_create(char* name)
+{
+  CompletionGroup* group = malloc(sizeof(CompletionGroup));
+  if(!group)
+    out_of_memory();
+
+  group->value    = name;
+  group->elements = NULL;
+  group->next     = NULL;
+
+  return group;
+}
+
+void
+completion_add_group(Completion* completion, CompletionGroup* group)
+{
+  CompletionGroup* cg = completion->groups;
+
+  while(cg && cg->next)
+    cg = cg->next;
+
+  if(cg)
+    cg->next = group;
+  else
+    completion->groups = group;
+}
+
+void completion_free(Completion* completion)
+{
+  CompletionGroup* group = completion->groups;
+  CompletionElement *element;
+
+  while(group)
+  {
+    element = group->elements;
+    while(element)
+    {
+      CompletionElement* ne = element->next;
+      free(element);
+      element = ne;
+    }
+
+    CompletionGroup *ng = group->next;
+    free(group);
+    group = ng;
+  }
+}
+
+void completion_group_add_element(CompletionGroup* group, char* name, char* description)
+{
+  CompletionElement* el = group->elements;
+
+  while(el && el->next)
+    el = el->next;
+
+  CompletionElement* new_element = malloc(sizeof(CompletionElement));
+  if(!new_element)
+    out_of_memory();
+
+  new_element->value       = name;
+  new_element->description = description;
+  new_element->next        = NULL;
+
+  if(el)
+    el->next = new_element;
+  else
+    group->elements = new_element;
+}
+
+/* shortcut implementation */
+void
+sc_abort(Argument* UNUSED(argument))
+{
+  /* Clear buffer */
+  if(Jumanji.Global.buffer)
+  {
+    g_string_free(Jumanji.Global.buffer, TRUE);
+    Jumanji.Global.buffer = NULL;
+    gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.buffer, "");
+  }
+
+  /* Clear hints */
+  hints_clear();
+
+  /* Stop loading website */
+  if(webkit_web_view_get_progress(GET_CURRENT_TAB()) == 1.0)
+    cmd_stop(0, NULL);
+
+  /* Set back to normal mode */
+  change_mode(NORMAL);
+
+  /* Hide inputbar */
+  gtk_widget_hide(GTK_WIDGET(Jumanji.UI.inputbar));
+
+  /* Unmark search results */
+  webkit_web_view_unmark_text_matches(GET_CURRENT_TAB());
+
+  gtk_widget_grab_focus(GTK_WIDGET(GET_CURRENT_TAB_WIDGET()));
+}
+
+void
+sc_change_buffer(Argument* argument)
+{
+  if(!Jumanji.Global.buffer)
+    return;
+
+  int buffer_length = Jumanji.Global.buffer->len;
+
+  if(argument->n == DELETE_LAST_CHAR)
+  {
+    if((buffer_length - 1) == 0)
+    {
+      g_string_free(Jumanji.Global.buffer, TRUE);
+      Jumanji.Global.buffer = NULL;
+      gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.buffer, "");
+    }
+    else
+    {
+      GString* temp = g_string_new_len(Jumanji.Global.buffer->str, buffer_length - 1);
+      g_string_free(Jumanji.Global.buffer, TRUE);
+      Jumanji.Global.buffer = temp;
+      gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.buffer, Jumanji.Global.buffer->str);
+    }
+
+    if(Jumanji.Global.mode == FOLLOW)
+    {
+      Argument argument = {0, NULL};
+      sc_follow_link(&argument);
+    }
+  }
+}
+
+void
+sc_change_mode(Argument* argument)
+{
+  if(argument)
+    change_mode(argument->n);
+}
+
+void
+sc_close_tab(Argument* UNUSED(argument))
+{
+  int current_tab = Jumanji.Tabs.current->position;
+  close_tab(current_tab);
+}
+
+void
+sc_focus_inputbar(Argument* argument)
+{
+  if(argument->data)
+  {
+    char* data = argument->data;
+
+    if(argument->n == APPEND_URL)
+      data = g_strdup_printf("%s%s", data, webkit_web_view_get_uri(GET_CURRENT_TAB()));
+    else
+      data = g_strdup(data);
+
+    notify(DEFAULT, data);
+    g_free(data);
+
+    /* selecting the text on focus would take over the X clipboard, the
+     * setting is shared by all entries and only suspended for this focus */
+    GtkSettings* settings    = gtk_widget_get_settings(GTK_WIDGET(Jumanji.UI.inputbar));
+    gboolean select_on_focus = FALSE;
+
+    g_object_get(G_OBJECT(settings), "gtk-entry-select-on-focus", &select_on_focus, NULL);
+    g_object_set(G_OBJECT(settings), "gtk-entry-select-on-focus", FALSE, NULL);
+    gtk_widget_grab_focus(GTK_WIDGET(Jumanji.UI.inputbar));
+    g_object_set(G_OBJECT(settings), "gtk-entry-select-on-focus", select_on_focus, NULL);
+    gtk_editable_set_position(GTK_EDITABLE(Jumanji.UI.inputbar), -1);
+  }
+
+  if(!(GTK_WIDGET_VISIBLE(GTK_WIDGET(Jumanji.UI.inputbar))))
+    gtk_widget_show(GTK_WIDGET(Jumanji.UI.inputbar));
+}
+
+void
+sc_follow_link(Argument* argument)
+{
+  static int open_mode = -1;
+  GdkEventKey *key = (GdkEventKey*)argument->data;
+
+  /* update open mode */
+  if(argument->n < 0)
+    open_mode = argument->n;
+
+  /* show all links */
+  if(!Jumanji.Hints.engine || Jumanji.Global.mode != FOLLOW)
+  {
+    hints_clear();
+    if(hints_show())
+      change_mode(FOLLOW);
+    return;
+  }
+
+  int hint = -1;
+
+  if (argument && argument->n == 10)
+    hint = Jumanji.Hints.active >= 0 ? Jumanji.Hints.active : Jumanji.Hints.first;
+  else if (key && key->keyval == GDK_Tab) {
+    hints_focus((key->state & GDK_CONTROL_MASK) ? -1 : 1);
+    return;
+  }
+  else
+  {
+    hints_filter(Jumanji.Global.buffer ? Jumanji.Global.buffer->str : "", FALSE);
+
+    if(Jumanji.Hints.matches == 1 && Jumanji.Global.buffer && Jumanji.Global.buffer->len > 0)
+      hint = Jumanji.Hints.first;
+  }
+
+  if(hint < 0)
+    return;
+
+  char* value = hints_follow(hint);
+
+  if(value && strlen(value))
+  {
+    if(open_mode == -1)
+      open_uri(GET_CURRENT_TAB(), value);
+    else
+      create_tab(value, TRUE);
+
+    sc_abort(NULL);
+  }
+  else
+  {
+    /* the element was clicked or focused in the page, which may already
+     * have switched to insert mode */
+    if(Jumanji.Global.buffer)
+    {
+      g_string_free(Jumanji.Global.buffer, TRUE);
+      Jumanji.Global.buffer = NULL;
+      gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.buffer, "");
+    }
+
+    if(Jumanji.Global.mode == FOLLOW)
+      change_mode(NORMAL);
+  }
+
+  g_free(value);
+}
+
+void
+sc_nav_history(Argument* argument)
+{
+  int steps = Jumanji.Global.count ? Jumanji.Global.count : 1;
+
+  if(argument->n == PREVIOUS)
+    steps = -steps;
+  else if(argument->n != NEXT)
+    return;
+
+  /* jump as far as the history allows in one step */
+  WebKitWebView* wv = GET_CURRENT_TAB();
+  while(steps && !webkit_web_view_can_go_back_or_forward(wv, steps))
+    steps += (steps > 0) ? -1 : 1;
+
+  if(steps)
+    webkit_web_view_go_back_or_forward(wv, steps);
+}
+
+void
+sc_nav_tabs(Argument* argument)
+{
+  bcmd_nav_tabs(NULL, argument);
+}
+
+void
+sc_paste(Argument* argument)
+{
+  /* the owner of the selection might be slow, so we do not wait for it */
+  gtk_clipboard_request_text(gtk_clipboard_get(GDK_SELECTION_PRIMARY), cb_clipboard_paste,
+      GINT_TO_POINTER(argument->n));
+}
+
+void
+sc_reload(Argument* argument)
+{
+  if(argument->n == BYPASS_CACHE)
+    webkit_web_view_reload_bypass_cache(GET_CURRENT_TAB());
+  else
+    webkit_web_view_reload(GET_CURRENT_TAB());
+}
+
+void
+sc_reopen(Argument* argument)
+{
+  GList *last_closed = g_list_first(Jumanji.Global.last_closed);
+
+  if(last_closed)
+  {
+    if(argument && argument->n)
+      create_tab(last_closed->data, TRUE);
+    else
+      create_tab(last_closed->data, FALSE);
+    Jumanji.Global.last_closed = g_list_remove(Jumanji.Global.last_closed, last_closed->data);
+  }
+}
+
+void
+sc_run_script(Argument* argument)
+{
+  if(argument->data)
+    run_script(argument->data, "sc_run_script", NULL, NULL);
+}
+
+void
+sc_scroll(Argument* argument)
+{
+  GtkAdjustment* adjustment;
+
+  if( (argument->n == LEFT) || (argument->n == RIGHT) || (argument->n == LEFT_MAX) || (argument->n == RIGHT_MAX) )
+    adjustment = gtk_scrolled_window_get_hadjustment(GET_CURRENT_TAB_WIDGET());
+  else
+    adjustment = gtk_scrolled_window_get_vadjustment(GET_CURRENT_TAB_WIDGET());
+
+  gdouble view_size  = gtk_adjustment_get_page_size(adjustment);
+  gdouble value      = gtk_adjustment_get_value(adjustment);
+  gdouble max        = gtk_adjustment_get_upper(adjustment) - view_size;
+  int     count      = Jumanji.Global.count ? Jumanji.Global.count : 1;
+
+  /* a count scales the step so the view is moved only once */
+  gdouble full_step  = view_size * count;
+  gdouble half_step  = (view_size / 2) * count;
+  gdouble step       = scroll_step * count;
+
+  if(argument->n == FULL_UP)
+    gtk_adjustment_set_value(adjustment, (value - full_step) < 0 ? 0 : (value - full_step));
+  else if(argument->n == FULL_DOWN)
+    gtk_adjustment_set_value(adjustment, (value + full_step) > max ? max : (value + full_step));
+  else if(argument->n == HALF_UP)
+    gtk_adjustment_set_value(adjustment, (value - half_step) < 0 ? 0 : (value - half_step));
+  else if(argument->n == HALF_DOWN)
+    gtk_adjustment_set_value(adjustment, (value + half_step) > max ? max : (value + half_step));
+  else if((argument->n == LEFT) || (argument->n == UP))
+    gtk_adjustment_set_value(adjustment, (value - step) < 0 ? 0 : (value - step));
+  else if(argument->n == TOP || argument->n == LEFT_MAX)
+    gtk_adjustment_set_value(adjustment, 0);
+  else if(argument->n == BOTTOM || argument->n == RIGHT_MAX)
+    gtk_adjustment_set_value(adjustment, max);
+  else
+    gtk_adjustment_set_value(adjustment, (value + step) > max ? max : (value + step));
+}
+
+void
+sc_search(Argument* argument)
+{
+  search_and_highlight(argument);
+}
+
+gboolean
+sessionsave(char* session_name)
+{
+  GString* session_uris = g_string_new("");
+
+  for (int i = 0; i < (int) Jumanji.Tabs.list->len; i++)
+  {
+    gchar* tab_uri_t = (gchar*) webkit_web_view_get_uri(GET_NTH_TAB(i));
+    gchar* tab_uri   = g_strconcat(tab_uri_t, " ", NULL);
+    session_uris     = g_string_append(session_uris, tab_uri);
+
+    g_free(tab_uri);
+  }
+
+  GList* se_list = Jumanji.Global.sessions;
+  while(se_list)
+  {
+    Session* se = se_list->data;
+
+    if(g_strcmp0(se->name, session_name) == 0)
+    {
+      g_free(se->uris);
+      se->uris = session_uris->str;
+
+      break;
+    }
+
+    se_list = g_list_next(se_list);
+  }
+
+  /* if there was no session with name == session_name */
+  if(!se_list)
+  {
+    Session* se = malloc(sizeof(Session));
+    se->name = g_strdup(session_name);
+    se->uris = session_uris->str;
+
+    Jumanji.Global.sessions = g_list_prepend(Jumanji.Global.sessions, se);
+  }
+
+  /* we don't free session_uris->str , just session_uris */
+  g_string_free(session_uris, FALSE);
+
+  return TRUE;
+}
+
+gboolean
+sessionswitch(char* session_name)
+{
+  // search for session
+  gchar** se_uris = NULL;
+
+  GList* se_list = Jumanji.Global.sessions;
+  while(se_list)
+  {
+    Session* se = se_list->data;
+
+    if(g_strcmp0(se->name, session_name) == 0)
+    {
+      se_uris = g_strsplit(se->uris, " ", -1);
+      break ;
+    }
+
+    se_list = g_list_next(se_list);
+  }
+
+  if(!se_uris)
+    return FALSE;
+
+  int nb_uris = g_strv_length(se_uris) - 1;
+
+  if(nb_uris <= 0)
+    return FALSE;
+
+  /* a session have been found
+   * we can start removing all the current tabs
+   * and attached informations */
+
+  // remove all markers
+  GList* list = Jumanji.Global.markers;
+  while(list)
+  {
+    GList* next_marker = g_list_next(list);
+
+    Marker* marker = (Marker*) list->data;
+    Jumanji.Global.markers = g_list_delete_link(Jumanji.Global.markers, list);
+    free(marker);
+
+    list = next_marker;
+  }
+
+  /* remove all the tabs
+   * without updating the status bar */
+  for (int i = Jumanji.Tabs.list->len - 1; i != -1; --i)
+    remove_tab(GET_TAB(i));
+
+  // load the session
+  batch_begin();
+
+  for(int i = 0; i < nb_uris; i++)
+    create_tab(se_uris[i], TRUE);
+
+  batch_end();
+
+  g_strfreev(se_uris);
+  return TRUE;
+}
+
+gboolean
+sessionload(char* session_name)
+{
+  GList* se_list = Jumanji.Global.sessions;
+  while(se_list)
+  {
+    Session* se = se_list->data;
+
+    if(g_strcmp0(se->name, session_name) == 0)
+    {
+      gchar** uris = g_strsplit(se->uris, " ", -1);
+      int     n    = g_strv_length(uris) - 1;
+
+      if(n <= 0)
+        return FALSE;
+
+      batch_begin();
+
+      for(int i = 0; i < n; i++)
+        create_tab(uris[i], TRUE);
+
+      batch_end();
+
+      g_strfreev(uris);
+      return TRUE;
+    }
+
+    se_list = g_list_next(se_list);
+  }
+
+  return FALSE;
+}
+
+void
+sc_spawn(Argument* argument)
+{
+  bcmd_spawn(NULL, argument);
+}
+
+void
+sc_toggle_offline(Argument* UNUSED(argument))
+{
+  if(!Jumanji.Tabs.current)
+    return;
+
+  Jumanji.Tabs.current->offline = !Jumanji.Tabs.current->offline;
+  notify(DEFAULT, Jumanji.Tabs.current->offline ? "Offline mode activated for this tab" : "Offline mode deactivated for this tab");
+
+  mark_dirty(DIRTY_URI);
+}
+
+void
+sc_toggle_proxy(Argument* UNUSED(argument))
+{
+  static gboolean enable = FALSE;
+
+  if(enable)
+  {
+    g_object_set(Jumanji.Soup.session, "proxy-uri", NULL, NULL);
+
+    if(Jumanji.Global.init_ui)
+      notify(DEFAULT, "Proxy deactivated");
+  }
+  else
+  {
+    char* purl = (proxy) ? proxy : (char*) g_getenv("http_proxy");
+    if(!purl)
+    {
+      if(Jumanji.Global.init_ui)
+        notify(DEFAULT, "No proxy defined");
+      return;
+    }
+
+    char* uri = strstr(purl, "://") ? g_strdup(purl) : g_strconcat("http://", purl, NULL);
+    SoupURI* proxy_uri = soup_uri_new(uri);
+
+    g_object_set(Jumanji.Soup.session, "proxy-uri", proxy_uri, NULL);
+
+    soup_uri_free(proxy_uri);
+    g_free(uri);
+
+    if(Jumanji.Global.init_ui)
+      notify(DEFAULT, "Proxy activated");
+  }
+
+  enable = !enable;
+}
+
+void
+sc_toggle_statusbar(Argument* UNUSED(argument))
+{
+  if(GTK_WIDGET_VISIBLE(GTK_WIDGET(Jumanji.UI.statusbar)))
+    gtk_widget_hide(GTK_WIDGET(Jumanji.UI.statusbar));
+  else
+    gtk_widget_show(GTK_WIDGET(Jumanji.UI.statusbar));
+}
+
+void
+sc_toggle_sourcecode(Argument* UNUSED(argument))
+{
+  gchar* uri = (char*) webkit_web_view_get_uri(GET_CURRENT_TAB());
+
+  if(webkit_web_view_get_view_source_mode(GET_CURRENT_TAB()))
+    webkit_web_view_set_view_source_mode(GET_CURRENT_TAB(), FALSE);
+  else
+    webkit_web_view_set_view_source_mode(GET_CURRENT_TAB(), TRUE);
+
+  open_uri(GET_CURRENT_TAB(), uri);
+}
+
+void
+sc_toggle_tabbar(Argument* UNUSED(argument))
+{
+  if(GTK_WIDGET_VISIBLE(GTK_WIDGET(Jumanji.UI.tabbar)))
+    gtk_widget_hide(GTK_WIDGET(Jumanji.UI.tabbar));
+  else
+    gtk_widget_show(GTK_WIDGET(Jumanji.UI.tabbar));
+}
+
+void
+sc_quit(Argument* UNUSED(argument))
+{
+  cb_destroy(NULL, NULL);
+}
+
+void
+sc_yank(Argument* argument)
+{
+  gchar* uri = (gchar*) webkit_web_view_get_uri(GET_CURRENT_TAB());
+  if (argument->n == XA_CLIPBOARD)
+    gtk_clipboard_set_text(gtk_clipboard_get(GDK_SELECTION_CLIPBOARD), uri, -1);
+  else if (argument->n == XA_SECONDARY)
+    gtk_clipboard_set_text(gtk_clipboard_get(GDK_SELECTION_SECONDARY), uri, -1);
+  else
+    gtk_clipboard_set_text(gtk_clipboard_get(GDK_SELECTION_PRIMARY), uri, -1);
+
+  gchar* message = g_strdup_printf("Yanked %s", uri);
+  notify(DEFAULT, message);
+  g_free(message);
+}
+
+void
+sc_zoom(Argument* argument)
+{
+  bcmd_zoom(NULL, argument);
+}
+
+/* inputbar shortcut declarations */
+void
+isc_abort(Argument* UNUSED(argument))
+{
+  Argument arg = { HIDE, NULL };
+  isc_completion(&arg);
+
+  notify(DEFAULT, "");
+  gtk_widget_grab_focus(GTK_WIDGET(GET_CURRENT_TAB_WIDGET()));
+  gtk_widget_hide(GTK_WIDGET(Jumanji.UI.inputbar));
+}
+
+void
+isc_completion(Argument* argument)
+{
+  gchar *input      = gtk_editable_get_chars(GTK_EDITABLE(Jumanji.UI.inputbar), 0, -1);
+  gchar  identifier = input[0];
+  gchar *input_m    = input + 1;
+  int    length     = strlen(input_m);
+
+  if(!length && !identifier)
+  {
+    g_free(input);
+    return;
+  }
+
+  /* get current information*/
+  char* first_space = strstr(input_m, " ");
+  char* current_command;
+  char* current_parameter;
+  int   current_command_length;
+
+  if(!first_space)
+  {
+    current_command          = input_m;
+    current_command_length   = length;
+    current_parameter        = NULL;
+  }
+  else
+  {
+    int offset               = abs(input_m - first_space);
+    current_command          = g_strndup(input_m, offset);
+    current_command_length   = strlen(current_command);
+    current_parameter        = input_m + offset + 1;
+  }
+
+  /* if the identifier does not match the command sign and
+   * the completion should not be hidden, leave this function */
+  if((identifier != ':') && (argument->n != HIDE))
+  {
+    g_free(input);
+    return;
+  }
+
+  /* static elements */
+  static GtkBox        *results = NULL;
+  static CompletionRow *rows    = NULL;
+
+  static int current_item = 0;
+  static int n_items      = 0;
+
+  static char *previous_command   = NULL;
+  static char *previous_parameter = NULL;
+  static int   previous_id        = 0;
+  static int   previous_length    = 0;
+
+  static gboolean command_mode = TRUE;
+
+  /* delete old list iff
+   *   the completion should be hidden
+   *   the current command differs from the previous one
+   *   the current parameter differs from the previous one
+   */
+  if( (argument->n == HIDE) ||
+      (current_parameter && previous_parameter && strcmp(current_parameter, previous_parameter)) ||
+      (current_command && previous_command && strcmp(current_command, previous_command)) ||
+      (previous_length != length)
+    )
+  {
+    if(results)
+      gtk_widget_destroy(GTK_WIDGET(results));
+
+    results = NULL;
+
+    if(rows)
+      free(rows);
+
+    rows         = NULL;
+    current_item = 0;
+    n_items      = 0;
+    command_mode = TRUE;
+
+    if(argument->n == HIDE)
+    {
+      g_free(input);
+      return;
+    }
+  }
+
+  /* create new list iff
+   *  there is no current list
+   *  the current command differs from the previous one
+   *  the current parameter differs from the previous one
+   */
+  if( (!results) )
+  {
+    results = GTK_BOX(gtk_vbox_new(FALSE, 0));
+
+    /* create list based on parameters iff
+     *  there is a current parameter given
+     *  there is an old list with commands (or not)
+     *  the current command does not differ from the previous one
+     *  the current command has an completion function
+     */
+    if(strchr(input_m, ' '))
+    {
+      gboolean search_matching_command = FALSE;
+
+      for(unsigned int i = 0; i < LENGTH(commands); i++)
+      {
+        int abbr_length = commands[i].abbr ? strlen(commands[i].abbr) : 0;
+        int cmd_length  = commands[i].command ? strlen(commands[i].command) : 0;
+
+        if( ((current_command_length <= cmd_length)  && !strncmp(current_command, commands[i].command, current_command_length)) ||
+            ((current_command_length <= abbr_length) && !strncmp(current_command, commands[i].abbr,    current_command_length))
+          )
+        {
+          if(commands[i].completion)
+          {
+            previous_command = current_command;
+            previous_id = i;
+            search_matching_command = TRUE;
+          }
+          else
+          {
+            g_free(input);
+            return;
+          }
+        }
+      }
+
+      if(!search_matching_command)
+      {
+        g_free(input);
+        return;
+      }
+
+      Completion *result = commands[previous_id].completion(current_parameter ? current_parameter : "");
+
+      if(!result || !result->groups)
+      {
+        g_free(input);
+        return;
+      }
+
+      command_mode               = FALSE;
+      CompletionGroup* group     = NULL;
+      CompletionElement* element = NULL;
+
+      rows = malloc(sizeof(CompletionRow));
+      if(!rows)
+        out_of_memory();
+
+      for(group = result->groups; group != NULL; group = group->next)
+      {
+        int group_elements = 0;
+
+        for(element = group->elements; element != NULL; element = element->next)
+        {
+          if(element->value)
+          {
+            if (group->value && !group_elements)
+            {
+              rows = realloc(rows, (n_items + 1) * sizeof(CompletionRow));
+              rows[n_items].command     = group->value;
+              rows[n_items].description = NULL;
+              rows[n_items].command_id  = -1;
+              rows[n_items].is_group    = TRUE;
+              rows[n_items++].row       = GTK_WIDGET(create_completion_row(results, group->value, NULL, TRUE));
+            }
+
+            rows = realloc(rows, (n_items + 1) * sizeof(CompletionRow));
+            rows[n_items].command     = element->value;
+            rows[n_items].description = element->description;
+            rows[n_items].command_id  = previous_id;
+            rows[n_items].is_group    = FALSE;
+            rows[n_items++].row       = GTK_WIDGET(create_completion_row(results, element->value, element->description, FALSE));
+            group_elements++;
+          }
+        }
+      }
+
+      /* clean up */
+      completion_free(result);
+    }
+    /* create list based on commands */
+    else
+    {
+      command_mode = TRUE;
+
+      rows = malloc(LENGTH(commands) * sizeof(CompletionRow));
+      if(!rows)
+        out_of_memory();
+
+      for(unsigned int i = 0; i < LENGTH(commands); i++)
+      {
+        int abbr_length = commands[i].abbr ? strlen(commands[i].abbr) : 0;
+        int cmd_length  = commands[i].command ? strlen(commands[i].command) : 0;
+
+        /* add command to list iff
+         *  the current command would match the command
+         *  the current command would match the abbreviation
+         */
+        if( ((current_command_length <= cmd_length)  && !strncmp(current_command, commands[i].command, current_command_length)) ||
+            ((current_command_length <= abbr_length) && !strncmp(current_command, commands[i].abbr,    current_command_length))
+          )
+        {
+          rows[n_items].command     = commands[i].command;
+          rows[n_items].description = commands[i].description;
+          rows[n_items].command_id  = i;
+          rows[n_items].is_group    = FALSE;
+          rows[n_items++].row       = GTK_WIDGET(create_completion_row(results, commands[i].command, commands[i].description, FALSE));
+        }
+      }
+
+      rows = realloc(rows, n_items * sizeof(CompletionRow));
+    }
+
+    gtk_box_pack_start(Jumanji.UI.box, GTK_WIDGET(results), FALSE, FALSE, 0);
+    gtk_widget_show(GTK_WIDGET(results));
+
+    current_item = (argument->n == NEXT) ? -1 : 0;
+  }
+
+  /* update coloring iff
+   *  there is a list with items
+   */
+  if( (results) && (n_items > 0) )
+  {
+    set_completion_row_color(results, NORMAL, current_item);
+    char* temp;
+    int i = 0, next_group = 0;
+
+    for(i = 0; i < n_items; i++)
+    {
+      if(argument->n == NEXT || argument->n == NEXT_GROUP)
+        current_item = (current_item + n_items + 1) % n_items;
+      else if(argument->n == PREVIOUS || argument->n == PREVIOUS_GROUP)
+        current_item = (current_item + n_items - 1) % n_items;
+
+      if(rows[current_item].is_group)
+      {
+        if(!command_mode && (argument->n == NEXT_GROUP || argument->n == PREVIOUS_GROUP))
+          next_group = 1;
+        continue;
+      }
+      else
+      {
+        if(!command_mode && (next_group == 0) && (argument->n == NEXT_GROUP || argument->n == PREVIOUS_GROUP))
+          continue;
+        break;
+      }
+    }
+
+    set_completion_row_color(results, HIGHLIGHT, current_item);
+
+    /* hide other items */
+    int uh = ceil(n_completion_items / 2);
+    int lh = floor(n_completion_items / 2);
+
+    for(i = 0; i < n_items; i++)
+    {
+     if((n_items > 1) && (
+        (i >= (current_item - lh) && (i <= current_item + uh)) ||
+        (i < n_completion_items && current_item < lh) ||
+        (i >= (n_items - n_completion_items) && (current_item >= (n_items - uh))))
+       )
+        gtk_widget_show(rows[i].row);
+      else
+        gtk_widget_hide(rows[i].row);
+    }
+
+    if(command_mode)
+      temp = g_strconcat(":", rows[current_item].command, (n_items == 1) ? " "  : NULL, NULL);
+    else
+      temp = g_strconcat(":", previous_command, " ", rows[current_item].command, NULL);
+
+    gtk_entry_set_text(Jumanji.UI.inputbar, temp);
+    gtk_editable_set_position(GTK_EDITABLE(Jumanji.UI.inputbar), -1);
+    g_free(temp);
+
+    previous_command   = (command_mode) ? rows[current_item].command : current_command;
+    previous_parameter = (command_mode) ? current_parameter : rows[current_item].command;
+    previous_length    = strlen(previous_command);
+    if(command_mode)
+      previous_length += length - current_command_length;
+    else
+      previous_length += strlen(previous_parameter) + 1;
+
+    previous_id        = rows[current_item].command_id;
+  }
+
+  g_free(input);
+}
+
+void
+isc_command_history(Argument* argument)
+{
+  static int current = 0;
+  int        length  = g_list_length(Jumanji.Global.command_history);
+
+  if(length > 0)
+  {
+    if(argument->n == NEXT)
+      current = (length + current + 1) % length;
+    else
+      current = (length + current - 1) % length;
+
+    gchar* command = (gchar*) g_list_nth_data(Jumanji.Global.command_history, current);
+    notify(DEFAULT, command);
+    gtk_editable_set_position(GTK_EDITABLE(Jumanji.UI.inputbar), -1);
+  }
+}
+
+void
+isc_string_manipulation(Argument* argument)
+{
+  gchar *input  = gtk_editable_get_chars(GTK_EDITABLE(Jumanji.UI.inputbar), 0, -1);
+  int    length = strlen(input);
+  int pos       = gtk_editable_get_position(GTK_EDITABLE(Jumanji.UI.inputbar));
+
+  if(argument->n == DELETE_LAST_WORD)
+  {
+    int i = pos - 1;
+
+    if(!pos)
+    {
+      g_free(input);
+      return;
+    }
+
+    /* remove trailing spaces */
+    for(; i >= 0 && input[i] == ' '; i--);
+
+    /* find the beginning of the word */
+    while((i == (pos - 1)) || (((i) > 0) && (input[i] != ' ')
+          && (input[i] != '/') && (input[i] != '.')
+          && (input[i] != '-') && (input[i] != '=')
+          && (input[i] != '&') && (input[i] != '#')
+          && (input[i] != '?')
+          ))
+      i--;
+
+    gtk_editable_delete_text(GTK_EDITABLE(Jumanji.UI.inputbar),  i+1, pos);
+    gtk_editable_set_position(GTK_EDITABLE(Jumanji.UI.inputbar), i+1);
+  }
+  else if(argument->n == DELETE_LAST_CHAR)
+  {
+    if((length - 1) <= 0)
+      isc_abort(NULL);
+
+    gtk_editable_delete_text(GTK_EDITABLE(Jumanji.UI.inputbar), pos - 1, pos);
+  }
+  else if(argument->n == NEXT_CHAR)
+    gtk_editable_set_position(GTK_EDITABLE(Jumanji.UI.inputbar), pos+1);
+  else if(argument->n == PREVIOUS_CHAR)
+    gtk_editable_set_position(GTK_EDITABLE(Jumanji.UI.inputbar), (pos == 0) ? 0 : pos - 1);
+
+  g_free(input);
+}
+
+/* command implementation */
+gboolean
+cmd_back(int UNUSED(argc), char** UNUSED(argv))
+{
+  Argument argument;
+  argument.n = PREVIOUS;
+  sc_nav_history(&argument);
+
+  return TRUE;
+}
+
+gboolean
+cmd_block(int argc, char** argv)
+{
+  /* without arguments the blocked requests are shown */
+  if(argc < 1)
+  {
+    gchar* message = g_strdup_printf("%d requests blocked on this page, %d in total",
+        Jumanji.Tabs.current ? Jumanji.Tabs.current->blocked : 0, Jumanji.Blocker.blocked);
+    notify(DEFAULT, message);
+    g_free(message);
+    return FALSE;
+  }
+
+  char* path = (argv[0][0] == '~') ? g_build_filename(g_get_home_dir(), argv[0] + 1, NULL) : g_strdup(argv[0]);
+
+  for(unsigned int i = 0; i < Jumanji.Blocker.lists->len; i++)
+  {
+    if(!strcmp(g_ptr_array_index(Jumanji.Blocker.lists, i), path))
+    {
+      g_free(path);
+      return TRUE;
+    }
+  }
+
+  g_ptr_array_add(Jumanji.Blocker.lists, path);
+
+  /* lists given one after another are compiled together */
+  if(Jumanji.Blocker.building)
+    Jumanji.Blocker.pending = TRUE;
+  else if(!Jumanji.Blocker.build_id)
+    Jumanji.Blocker.build_id = g_idle_add(cb_blocker_build, NULL);
+
+  return TRUE;
+}
+
+gboolean
+cmd_bmap(int argc, char** argv)
+{
+  if(argc < 2)
+    return TRUE;
+
+  /* search for the right buffered command function mapping */
+  int bc_id = -1;
+
+  for(unsigned int bc_c = 0; bc_c < LENGTH(function_names); bc_c++)
+  {
+    if(!strcmp(argv[1], function_names[bc_c].name) && function_names[bc_c].bcmd)
+    {
+      bc_id = bc_c;
+      break;
+    }
+  }
+
+  if(bc_id == -1)
+  {
+    notify(WARNING, "No such buffered command function exists");
+    return FALSE;
+  }
+
+  /* parse argument */
+  Argument arg = {0, 0};
+
+  if(argc >= 3)
+  {
+    int arg_id = -1;
+
+    /* compare argument with given argument names... */
+    for(unsigned int arg_c = 0; arg_c < LENGTH(argument_names); arg_c++)
+    {
+      if(!strcmp(argv[2], argument_names[arg_c].name))
+      {
+        arg_id = argument_names[arg_c].argument;
+        break;
+      }
+    }
+
+    /* if not, save it do .data */
+    if(arg_id == -1)
+      arg.data = argv[2];
+    else
+      arg.n = arg_id;
+  }
+
+  /* search for existing buffered command to overwrite it */
+  BufferCommandList* bc = Jumanji.Bindings.bcmdlist;
+  while(bc && bc->next != NULL)
+  {
+    if(!strcmp(bc->element.regex, argv[0]))
+    {
+      bc->element.function = function_names[bc_id].bcmd;
+      bc->element.argument = arg;
+      return TRUE;
+    }
+
+    bc = bc->next;
+  }
+
+  /* create new entry */
+  BufferCommandList* entry = malloc(sizeof(BufferCommandList));
+  if(!entry)
+    out_of_memory();
+
+  entry->element.regex    = argv[0];
+  entry->element.function = function_names[bc_id].bcmd;
+  entry->element.argument = arg;
+  entry->next             = NULL;
+
+  /* append to list */
+  if(!Jumanji.Bindings.bcmdlist)
+    Jumanji.Bindings.bcmdlist = entry;
+
+  if(bc)
+    bc->next = entry;
+
+  return TRUE;
+}
+
+gboolean
+cmd_bookmark(int argc, char** argv)
+{
+  char* bookmark = g_strdup(webkit_web_view_get_uri(GET_CURRENT_TAB()));
+
+  /* at first we verify that bookmark (without tag) isn't already in the list */
+  unsigned int bookmark_length = strlen(bookmark);
+  for(GList* l = Jumanji.Global.bookmarks; l; l = g_list_next(l))
+  {
+    if(!strncmp(bookmark, (char*) l->data, bookmark_length))
+    {
+      /* we remove the former bookmark so tags will be updated by the new ones */
+      g_free(l->data);
+      Jumanji.Global.bookmarks = g_list_delete_link(Jumanji.Global.bookmarks, l);
+      break;
+    }
+  }
+
+  /* I am sure argv end with NULL since it was generate by g_strsplit()
+   * in cb_inputbar_activate.
+   * Even if I know (argv[argc] == NULL) I test it since apply g_strjoinv
+   * to a non NULL terminated array would be VERY problematic.
+   * So I protect cmd_bookmark from bad cb_inputbar_activate modification.
+   */
+
+  /* if there is tags we add it to the bookmark string
+   * -> append it to the bookmark
+   */
+  if(argc >= 1 && argv[argc] == NULL)
+  {
+    char* tags = g_strjoinv(" ", argv);
+    char* bookmark_temp = bookmark;
+    bookmark = g_strjoin(" ", bookmark, tags, NULL);
+
+    g_free(bookmark_temp);
+    g_free(tags);
+  }
+
+  Jumanji.Global.bookmarks = g_list_append(Jumanji.Global.bookmarks, bookmark);
+
+  return TRUE;
+}
+
+gboolean
+cmd_cache(int argc, char** argv)
+{
+  if(!Jumanji.Soup.cache)
+    return FALSE;
+
+  if(argc > 0 && !strcmp(argv[0], "clear"))
+  {
+    soup_cache_clear(Jumanji.Soup.cache);
+    notify(DEFAULT, "Cache cleared");
+    return FALSE;
+  }
+  else if(argc > 0)
+  {
+    notify(ERROR, "Usage: cache [clear]");
+    return FALSE;
+  }
+
+  /* size of the entries on disk */
+  char*  cache_dir = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_CACHE, NULL);
+  GDir*  dir       = g_dir_open(cache_dir, 0, NULL);
+  gint64 size      = 0;
+
+  for(const char* name; dir && (name = g_dir_read_name(dir));)
+  {
+    char* path = g_build_filename(cache_dir, name, NULL);
+    struct stat info;
+
+    if(!stat(path, &info))
+      size += info.st_size;
+
+    g_free(path);
+  }
+
+  if(dir)
+    g_dir_close(dir);
+  g_free(cache_dir);
+
+  int cached = MAX(Jumanji.Soup.requests - Jumanji.Soup.network, 0);
+  gchar* message = g_strdup_printf("Cache: %" G_GINT64_FORMAT " of %u MB, %d requests, %d from cache, %d revalidated, %d from network",
+      size / (1024 * 1024), soup_cache_get_max_size(Jumanji.Soup.cache) / (1024 * 1024), Jumanji.Soup.requests,
+      cached, Jumanji.Soup.revalidated, Jumanji.Soup.network - Jumanji.Soup.revalidated);
+  notify(DEFAULT, message);
+  g_free(message);
+
+  return FALSE;
+}
+
+gboolean
+cmd_forward(int UNUSED(argc), char** UNUSED(argv))
+{
+  Argument argument;
+  argument.n = NEXT;
+  sc_nav_history(&argument);
+
+  return TRUE;
+}
+
+gboolean
+cmd_har(int argc, char** argv)
+{
+  if(argc != 1)
+  {
+    notify(ERROR, "Usage: har <file>");
+    return FALSE;
+  }
+
+  if(!Jumanji.Tabs.current || !Jumanji.Tabs.current->requests || !Jumanji.Tabs.current->requests->len)
+  {
+    notify(ERROR, "No requests have been recorded in this tab");
+    return FALSE;
+  }
+
+  GPtrArray* requests = Jumanji.Tabs.current->requests;
+  GString*   output   = g_string_new("{\"log\":{\"version\":\"1.2\",\"creator\":{\"name\":\"jumanji\",\"version\":");
+  json_append_string(output, browser_name);
+  g_string_append(output, "},\"pages\":[{\"id\":\"page\",\"title\":");
+  json_append_string(output, webkit_web_view_get_title(GET_CURRENT_TAB()));
+  g_string_append(output, ",\"startedDateTime\":");
+  json_append_date(output, ((RequestTiming*) g_ptr_array_index(requests, 0))->started);
+  g_string_append(output, ",\"pageTimings\":{}}],\"entries\":[");
+
+  for(unsigned int i = 0; i < requests->len; i++)
+  {
+    RequestTiming* timing = (RequestTiming*) g_ptr_array_index(requests, i);
+
+    /* cached responses have no connection phases, send, wait and receive
+     * are mandatory in har */
+    gint64 connection = timing->resolving >= 0 ? timing->resolving : (timing->connecting >= 0 ? timing->connecting : timing->sent);
+    double blocked    = timing_span(timing->queued, connection);
+    double dns        = timing_span(timing->resolving, timing->resolved);
+    double connect    = timing_span(timing->connecting, timing->connected);
+    double ssl        = timing_span(timing->handshaking, timing->connected);
+    double send       = MAX(timing_span(timing->sent, timing->wrote), 0);
+    double wait       = MAX(timing_span(timing->wrote >= 0 ? timing->wrote : timing->sent, timing->headers), 0);
+    double receive    = MAX(timing_span(timing->headers, timing->body >= 0 ? timing->body : timing->finished), 0);
+    const char* version = (timing->finished < 0) ? "" : (timing->http_version ? "HTTP/1.1" : "HTTP/1.0");
+
+    g_string_append(output, i ? ",{\"pageref\":\"page\",\"startedDateTime\":" : "{\"pageref\":\"page\",\"startedDateTime\":");
+    json_append_date(output, timing->started);
+    g_string_append_c(output, ',');
+    json_append_number(output, "time", MAX(blocked, 0) + MAX(dns, 0) + MAX(connect, 0) + send + wait + receive);
+
+    g_string_append(output, ",\"request\":{\"method\":");
+    json_append_string(output, timing->method);
+    g_string_append(output, ",\"url\":");
+    json_append_string(output, timing->uri);
+    g_string_append(output, ",\"httpVersion\":");
+    json_append_string(output, version);
+    g_string_append(output, ",\"cookies\":[],\"headers\":[],\"queryString\":[],\"headersSize\":-1,\"bodySize\":-1}");
+
+    g_string_append_printf(output, ",\"response\":{\"status\":%u,\"statusText\":", timing->status);
+    json_append_string(output, timing->status_text);
+    g_string_append(output, ",\"httpVersion\":");
+    json_append_string(output, version);
+    g_string_append_printf(output, ",\"cookies\":[],\"headers\":[],\"content\":{\"size\":%" G_GINT64_FORMAT ",\"mimeType\":",
+        (gint64) timing->size);
+    json_append_string(output, timing->mime_type);
+    g_string_append_printf(output, "},\"redirectURL\":\"\",\"headersSize\":-1,\"bodySize\":%" G_GINT64_FORMAT "}",
+        (gint64) timing->size);
+
+    g_string_append(output, ",\"cache\":{},\"timings\":{");
+    json_append_number(output, "blocked", blocked);
+    g_string_append_c(output, ',');
+    json_append_number(output, "dns", dns);
+    g_string_append_c(output, ',');
+    json_append_number(output, "connect", connect);
+    g_string_append_c(output, ',');
+    json_append_number(output, "ssl", ssl);
+    g_string_append_c(output, ',');
+    json_append_number(output, "send", send);
+    g_string_append_c(output, ',');
+    json_append_number(output, "wait", wait);
+    g_string_append_c(output, ',');
+    json_append_number(output, "receive", receive);
+    g_string_append(output, "}}");
+  }
+
+  g_string_append(output, "]}}\n");
+
+  char*    path    = (argv[0][0] == '~') ? g_build_filename(g_get_home_dir(), argv[0] + 1, NULL) : g_strdup(argv[0]);
+  gboolean written = g_file_set_contents(path, output->str, -1, NULL);
+
+  if(!written)
+  {
+    gchar* message = g_strdup_printf("Could not write file '%s'", path);
+    notify(ERROR, message);
+    g_free(message);
+  }
+
+  g_free(path);
+  g_string_free(output, TRUE);
+
+  return written;
+}
+
+gboolean
+cmd_hide(int argc, char** argv)
+{
+  if(argc < 1)
+    return TRUE;
+
+  char* content = read_file(argv[0]);
+
+  if(!content)
+  {
+    gchar* message = g_strdup_printf("Could not open or read file '%s'", argv[0]);
+    notify(ERROR, message);
+    g_free(message);
+    return FALSE;
+  }
+
+  /* element hiding rules look like 'domain,domain##selector' or '##selector';
+   * exceptions and rules for all but some domains are not supported */
+  gchar** lines = g_strsplit(content, "\n", -1);
+  free(content);
+
+  for(gchar** line = lines; *line; line++)
+  {
+    char* rule      = g_strstrip(*line);
+    char* separator = strstr(rule, "##");
+
+    if(*rule == '!' || !separator || !*(separator + 2))
+      continue;
+
+    *separator = '\0';
+    if(strchr(rule, '~'))
+      continue;
+
+    gchar** domains = g_strsplit(rule, ",", -1);
+
+    /* rules without domains apply to all of them */
+    if(!*domains)
+      add_hiding_rule("", separator + 2);
+
+    for(gchar** domain = domains; *domain; domain++)
+      if(*g_strstrip(*domain))
+        add_hiding_rule(*domain, separator + 2);
+
+    g_strfreev(domains);
+  }
+
+  g_strfreev(lines);
+
+  /* compile the sheets again when they are needed */
+  g_hash_table_remove_all(Jumanji.Hiding.sheets);
+
+  return TRUE;
+}
+
+gboolean
+cmd_map(int argc, char** argv)
+{
+  if(argc < 2)
+    return TRUE;
+
+  char* ks = argv[0];
+
+  /* search for the right shortcut function */
+  int sc_id = -1;
+
+  for(unsigned int sc_c = 0; sc_c < LENGTH(function_names); sc_c++)
+  {
+    if(!strcmp(argv[1], function_names[sc_c].name) && function_names[sc_c].sc)
+    {
+      sc_id = sc_c;
+      break;
+    }
+  }
+
+  if(sc_id == -1)
+  {
+    notify(WARNING, "No such shortcut function exists");
+    return FALSE;
+  }
+
+  /* parse modifier and key */
+  unsigned int mask = 0;
+  unsigned int key  = 0;
+  int keyl = strlen(ks);
+  int mode = NORMAL;
+
+  // single key (e.g.: g)
+  if(keyl == 1)
+    key = ks[0];
+
+  // modifier and key (e.g.: <S-g>
+  // special key or modifier and key/special key (e.g.: <S-g>, <Space>)
+
+  else if(keyl >= 3 && ks[0] == '<' && ks[keyl-1] == '>')
+  {
+    char* specialkey = NULL;
+
+    /* check for modifier */
+    if(keyl >= 5 && ks[2] == '-')
+    {
+      /* evaluate modifier */
+      switch(ks[1])
+      {
+        case 'S':
+          mask = GDK_SHIFT_MASK;
+          break;
+        case 'C':
+          mask = GDK_CONTROL_MASK;
+          break;
+        case 'W':
+          mask = GDK_SUPER_MASK | GDK_MOD4_MASK;
+          break;
+        case 'A':
+          mask = GDK_MOD1_MASK;
+          break;
+      }
+
+      /* no valid modifier */
+      if(!mask)
+      {
+        notify(WARNING, "No valid modifier given.");
+        return FALSE;
+      }
+
+      /* modifier and special key */
+      if(keyl > 5)
+        specialkey = g_strndup(ks + 3, keyl - 4);
+      else
+        key = ks[3];
+    }
+    else
+      specialkey = ks;
+
+    /* search special key */
+    for(unsigned int g_c = 0; specialkey && g_c < LENGTH(gdk_keys); g_c++)
+    {
+      if(!strcmp(specialkey, gdk_keys[g_c].identifier))
+      {
+        key = gdk_keys[g_c].key;
+        break;
+      }
+    }
+
+    if(specialkey)
+      g_free(specialkey);
+  }
+
+  if(!key)
+  {
+    notify(WARNING, "No valid key binding given.");
+    return FALSE;
+  }
+
+  /* parse argument */
+  Argument arg = {0, 0};
+
+  if(argc >= 3)
+  {
+    int arg_id = -1;
+
+    /* compare argument with given argument names... */
+    for(unsigned int arg_c = 0; arg_c < LENGTH(argument_names); arg_c++)
+    {
+      if(!strcmp(argv[2], argument_names[arg_c].name))
+      {
+        arg_id = argument_names[arg_c].argument;
+        break;
+      }
+    }
+
+    /* if not, save it do .data */
+    if(arg_id == -1)
+      arg.data = argv[2];
+    else
+      arg.n = arg_id;
+  }
+
+  /* parse mode */
+  if(argc >= 4)
+  {
+    for(unsigned int mode_c = 0; mode_c < LENGTH(mode_names); mode_c++)
+    {
+      if(!strcmp(argv[3], mode_names[mode_c].name))
+      {
+        mode = mode_names[mode_c].mode;
+        break;
+      }
+    }
+  }
+
+  /* search for existing binding to overwrite it */
+  ShortcutList* sc = Jumanji.Bindings.sclist;
+  while(sc && sc->next != NULL)
+  {
+    if(
+       sc->element.key == key
+       && sc->element.mask == mask
+       && sc->element.mode == mode
+      )
+    {
+      sc->element.function = function_names[sc_id].sc;
+      sc->element.argument = arg;
+      return TRUE;
+    }
+
+    sc = sc->next;
+  }
 
-      rows = realloc(rows, n_items * sizeof(CompletionRow));
-    }
+  /* create new entry */
+  ShortcutList* entry = malloc(sizeof(ShortcutList));
+  if(!entry)
+    out_of_memory();
 
-    gtk_box_pack_start(Jumanji.UI.box, GTK_WIDGET(results), FALSE, FALSE, 0);
-    gtk_widget_show(GTK_WIDGET(results));
+  entry->element.mask     = mask;
+  entry->element.key      = key;
+  entry->element.function = function_names[sc_id].sc;
+  entry->element.mode     = mode;
+  entry->element.argument = arg;
+  entry->next             = NULL;
 
-    current_item = (argument->n == NEXT) ? -1 : 0;
-  }
+  /* append to list */
+  if(!Jumanji.Bindings.sclist)
+    Jumanji.Bindings.sclist = entry;
 
-  /* update coloring iff
-   *  there is a list with items
-   */
-  if( (results) && (n_items > 0) )
-  {
-    set_completion_row_color(results, NORMAL, current_item);
-    char* temp;
-    int i = 0, next_group = 0;
+  if(sc)
+    sc->next = entry;
 
-    for(i = 0; i < n_items; i++)
-    {
-      if(argument->n == NEXT || argument->n == NEXT_GROUP)
-        current_item = (current_item + n_items + 1) % n_items;
-      else if(argument->n == PREVIOUS || argument->n == PREVIOUS_GROUP)
-        current_item = (current_item + n_items - 1) % n_items;
+  return TRUE;
+}
 
-      if(rows[current_item].is_group)
-      {
-        if(!command_mode && (argument->n == NEXT_GROUP || argument->n == PREVIOUS_GROUP))
-          next_group = 1;
-        continue;
-      }
-      else
-      {
-        if(!command_mode && (next_group == 0) && (argument->n == NEXT_GROUP || argument->n == PREVIOUS_GROUP))
-          continue;
-        break;
-      }
-    }
+gboolean
+cmd_open(int argc, char** argv)
+{
+  if(argc <= 0)
+    return TRUE;
 
-    set_completion_row_color(results, HIGHLIGHT, current_item);
+  if(argv[argc] != NULL)
+    return TRUE;
 
-    /* hide other items */
-    int uh = ceil(n_completion_items / 2);
-    int lh = floor(n_completion_items / 2);
+  char* uri = g_strjoinv(" ", argv);
 
-    for(i = 0; i < n_items; i++)
-    {
-     if((n_items > 1) && (
-        (i >= (current_item - lh) && (i <= current_item + uh)) ||
-        (i < n_completion_items && current_item < lh) ||
-        (i >= (n_items - n_completion_items) && (current_item >= (n_items - uh))))
-       )
-        gtk_widget_show(rows[i].row);
-      else
-        gtk_widget_hide(rows[i].row);
-    }
+  open_uri(GET_CURRENT_TAB(), uri);
+  g_free(uri);
 
-    if(command_mode)
-      temp = g_strconcat(":", rows[current_item].command, (n_items == 1) ? " "  : NULL, NULL);
-    else
-      temp = g_strconcat(":", previous_command, " ", rows[current_item].command, NULL);
+  return TRUE;
+}
 
-    gtk_entry_set_text(Jumanji.UI.inputbar, temp);
-    gtk_editable_set_position(GTK_EDITABLE(Jumanji.UI.inputbar), -1);
-    g_free(temp);
+gboolean
+cmd_print(int UNUSED(argc), char** UNUSED(argv))
+{
+  WebKitWebFrame* frame = webkit_web_view_get_main_frame(GET_CURRENT_TAB());
 
-    previous_command   = (command_mode) ? rows[current_item].command : current_command;
-    previous_parameter = (command_mode) ? current_parameter : rows[current_item].command;
-    previous_length    = strlen(previous_command);
-    if(command_mode)
-      previous_length += length - current_command_length;
-    else
-      previous_length += strlen(previous_parameter) + 1;
+  if(!frame)
+    return FALSE;
 
-    previous_id        = rows[current_item].command_id;
-  }
+  webkit_web_frame_print(frame);
 
-  g_free(input);
+  return TRUE;
 }
 
-void
-isc_command_history(Argument* argument)
+gboolean
+cmd_profile(int argc, char** argv)
 {
-  static int current = 0;
-  int        length  = g_list_length(Jumanji.Global.command_history);
-
-  if(length > 0)
+  if(argc > 0 && !strcmp(argv[0], "clear"))
   {
-    if(argument->n == NEXT)
-      current = (length + current + 1) % length;
-    else
-      current = (length + current - 1) % length;
+    g_hash_table_remove_all(Jumanji.Global.profiles);
+    return TRUE;
+  }
 
-    gchar* command = (gchar*) g_list_nth_data(Jumanji.Global.command_history, current);
-    notify(DEFAULT, command);
-    gtk_editable_set_position(GTK_EDITABLE(Jumanji.UI.inputbar), -1);
+  gboolean export = argc > 1 && !strcmp(argv[0], "export");
+
+  if(argc > 0 && !export)
+  {
+    notify(ERROR, "Usage: profile [clear|export <file>]");
+    return FALSE;
   }
-}
 
-void
-isc_string_manipulation(Argument* argument)
-{
-  gchar *input  = gtk_editable_get_chars(GTK_EDITABLE(Jumanji.UI.inputbar), 0, -1);
-  int    length = strlen(input);
-  int pos       = gtk_editable_get_position(GTK_EDITABLE(Jumanji.UI.inputbar));
+  /* the most expensive scripts come first */
+  GList*   profiles = g_list_sort(g_hash_table_get_values(Jumanji.Global.profiles), compare_script_profiles);
+  GString* output   = g_string_new(export ? "script\tcaller\tcalls\texceptions\ttotal\tmax\n" :
+      "<html><head><title>Script profile</title></head><body><table>"
+      "<tr><th>Script</th><th>Caller</th><th>Calls</th><th>Exceptions</th><th>Total (ms)</th><th>Max (ms)</th></tr>");
 
-  if(argument->n == DELETE_LAST_WORD)
+  for(GList* l = profiles; l; l = g_list_next(l))
   {
-    int i = pos - 1;
+    ScriptProfile* profile = (ScriptProfile*) l->data;
 
-    if(!pos)
+    if(export)
     {
-      g_free(input);
-      return;
+      /* inline scripts may contain tabs and newlines */
+      char* script = g_strdelimit(g_strdup(profile->script), "\t\n", ' ');
+      g_string_append_printf(output, "%s\t%s\t%d\t%d\t%.3f\t%.3f\n", script, profile->caller,
+          profile->calls, profile->exceptions, profile->total, profile->max);
+      g_free(script);
+    }
+    else
+    {
+      char* script = g_markup_escape_text(profile->script, -1);
+      g_string_append_printf(output, "<tr><td>%s</td><td>%s</td><td>%d</td><td>%d</td><td>%.3f</td><td>%.3f</td></tr>",
+          script, profile->caller, profile->calls, profile->exceptions, profile->total, profile->max);
+      g_free(script);
     }
+  }
 
-    /* remove trailing spaces */
-    for(; i >= 0 && input[i] == ' '; i--);
+  g_list_free(profiles);
 
-    /* find the beginning of the word */
-    while((i == (pos - 1)) || (((i) > 0) && (input[i] != ' ')
-          && (input[i] != '/') && (input[i] != '.')
-          && (input[i] != '-') && (input[i] != '=')
-          && (input[i] != '&') && (input[i] != '#')
-          && (input[i] != '?')
-          ))
-      i--;
+  if(export)
+  {
+    char* path = (argv[1][0] == '~') ? g_build_filename(g_get_home_dir(), argv[1] + 1, NULL) : g_strdup(argv[1]);
 
-    gtk_editable_delete_text(GTK_EDITABLE(Jumanji.UI.inputbar),  i+1, pos);
-    gtk_editable_set_position(GTK_EDITABLE(Jumanji.UI.inputbar), i+1);
+    if(!g_file_set_contents(path, output->str, -1, NULL))
+    {
+      gchar* message = g_strdup_printf("Could not write file '%s'", path);
+      notify(ERROR, message);
+      g_free(message);
+    }
+
+    g_free(path);
   }
-  else if(argument->n == DELETE_LAST_CHAR)
+  else
   {
-    if((length - 1) <= 0)
-      isc_abort(NULL);
+    g_string_append_printf(output, "</table><p>Garbage collection: %d passes, %d collections, resident memory changed by %+" G_GINT64_FORMAT " kB across them</p></body></html>",
+        Jumanji.Collector.passes, Jumanji.Collector.collections, Jumanji.Collector.rss_change / 1024);
 
-    gtk_editable_delete_text(GTK_EDITABLE(Jumanji.UI.inputbar), pos - 1, pos);
+    GtkWidget* widget = create_tab("about:blank", FALSE);
+    if(widget)
+    {
+      Tab* tab = (Tab*) g_object_get_data(G_OBJECT(widget), "tab");
+      webkit_web_view_load_string(tab->view, output->str, "text/html", "UTF-8", "about:profile");
+    }
   }
-  else if(argument->n == NEXT_CHAR)
-    gtk_editable_set_position(GTK_EDITABLE(Jumanji.UI.inputbar), pos+1);
-  else if(argument->n == PREVIOUS_CHAR)
-    gtk_editable_set_position(GTK_EDITABLE(Jumanji.UI.inputbar), (pos == 0) ? 0 : pos - 1);
 
-  g_free(input);
+  g_string_free(output, TRUE);
+
+  return TRUE;
 }
 
-/* command implementation */
 gboolean
-cmd_back(int UNUSED(argc), char** UNUSED(argv))
+cmd_quit(int UNUSED(argc), char** UNUSED(argv))
 {
-  Argument argument;
-  argument.n = PREVIOUS;
-  sc_nav_history(&argument);
+  sc_close_tab(NULL);
+  return TRUE;
+}
 
+gboolean
+cmd_quitall(int UNUSED(argc), char** UNUSED(argv))
+{
+  cb_destroy(NULL, NULL);
   return TRUE;
 }
 
 gboolean
-cmd_bmap(int argc, char** argv)
+cmd_reload(int UNUSED(argc), char** UNUSED(argv))
 {
-  if(argc < 2)
-    return TRUE;
+  Argument argument = {0, 0};
+  sc_reload(&argument);
 
-  /* search for the right buffered command function mapping */
-  int bc_id = -1;
+  return TRUE;
+}
 
-  for(unsigned int bc_c = 0; bc_c < LENGTH(function_names); bc_c++)
+gboolean
+cmd_reload_all(int UNUSED(argc), char** UNUSED(argv))
+{
+  int number_of_tabs = (int) Jumanji.Tabs.list->len;
+  int i;
+
+  for(i = 0; i < number_of_tabs; i++)
+    webkit_web_view_reload_bypass_cache(GET_NTH_TAB(i));
+
+  return TRUE;
+}
+
+gboolean
+cmd_saveas(int argc, char** argv)
+{
+  char* filename;
+
+  if(argc > 0)
+    filename = argv[0];
+  else
+    filename = (char*) webkit_web_view_get_title(GET_CURRENT_TAB());
+
+  char* uri       = (char*) webkit_web_view_get_uri(GET_CURRENT_TAB());
+  char* file      = g_strconcat(download_dir, filename ? filename : uri, NULL);
+  char* command   = g_strdup_printf(download_command, uri, file);
+
+  g_spawn_command_line_async(command, NULL);
+
+  g_free(command);
+  g_free(file);
+
+  return TRUE;
+}
+
+gboolean
+cmd_script(int argc, char** argv)
+{
+  /* without arguments the injections into the current page are shown */
+  if(argc < 1)
   {
-    if(!strcmp(argv[1], function_names[bc_c].name) && function_names[bc_c].bcmd)
+    if(Jumanji.Tabs.current)
     {
-      bc_id = bc_c;
-      break;
+      gchar* message = g_strdup_printf("%d script injections into %d frames",
+          Jumanji.Tabs.current->injections, Jumanji.Tabs.current->frames);
+      notify(DEFAULT, message);
+      g_free(message);
     }
-  }
 
-  if(bc_id == -1)
-  {
-    notify(WARNING, "No such buffered command function exists");
     return FALSE;
   }
 
-  /* parse argument */
-  Argument arg = {0, 0};
+  char* path    = argv[0];
+  gboolean all_frames = TRUE;
+  int first_pattern   = 1;
 
-  if(argc >= 3)
+  if(argc > 1 && (!strcmp(argv[1], "main") || !strcmp(argv[1], "all")))
   {
-    int arg_id = -1;
+    all_frames    = !strcmp(argv[1], "all");
+    first_pattern = 2;
+  }
 
-    /* compare argument with given argument names... */
-    for(unsigned int arg_c = 0; arg_c < LENGTH(argument_names); arg_c++)
-    {
-      if(!strcmp(argv[2], argument_names[arg_c].name))
-      {
-        arg_id = argument_names[arg_c].argument;
-        break;
-      }
-    }
+  /* the remaining arguments are url patterns */
+  char** patterns = g_new0(char*, argc - first_pattern + 1);
+  for(int i = first_pattern; i < argc; i++)
+    patterns[i - first_pattern] = g_strdup(argv[i]);
 
-    /* if not, save it do .data */
-    if(arg_id == -1)
-      arg.data = argv[2];
-    else
-      arg.n = arg_id;
+  char* content = read_file(path);
+
+  if(!content)
+  {
+    gchar* message = g_strdup_printf("Could not open or read file '%s'", path);
+    notify(ERROR, message);
+    g_free(message);
+    g_strfreev(patterns);
+    return FALSE;
   }
 
-  /* search for existing buffered command to overwrite it */
-  BufferCommandList* bc = Jumanji.Bindings.bcmdlist;
-  while(bc && bc->next != NULL)
+  /* search for existing script to overwrite or reread it */
+  ScriptList* sl = Jumanji.Global.scripts;
+  while(sl)
   {
-    if(!strcmp(bc->element.regex, argv[0]))
+    if(!strcmp(sl->path, path))
     {
-      bc->element.function = function_names[bc_id].bcmd;
-      bc->element.argument = arg;
+      invalidate_script_source(sl);
+      free(sl->content);
+      g_strfreev(sl->patterns);
+      sl->content    = content;
+      sl->all_frames = all_frames;
+      sl->patterns   = patterns;
+      compile_script_patterns(sl);
       return TRUE;
     }
 
-    bc = bc->next;
+    if(!sl->next)
+      break;
+
+    sl = sl->next;
   }
 
-  /* create new entry */
-  BufferCommandList* entry = malloc(sizeof(BufferCommandList));
+  /* load new script */
+  ScriptList* entry = malloc(sizeof(ScriptList));
   if(!entry)
     out_of_memory();
 
-  entry->element.regex    = argv[0];
-  entry->element.function = function_names[bc_id].bcmd;
-  entry->element.argument = arg;
-  entry->next             = NULL;
+  entry->path       = g_strdup(path);
+  entry->content    = content;
+  entry->source     = NULL;
+  entry->all_frames = all_frames;
+  entry->patterns   = patterns;
+  entry->include    = NULL;
+  entry->exclude    = NULL;
+  entry->next       = NULL;
+
+  compile_script_patterns(entry);
+
+  /* reread the script when it changes */
+  char* file_path = (path[0] == '~') ? g_build_filename(g_get_home_dir(), path + 1, NULL) : g_strdup(path);
+  GFile* file     = g_file_new_for_path(file_path);
+  entry->monitor  = g_file_monitor_file(file, G_FILE_MONITOR_NONE, NULL, NULL);
+  g_object_unref(file);
+  g_free(file_path);
+
+  if(entry->monitor)
+    g_signal_connect(G_OBJECT(entry->monitor), "changed", G_CALLBACK(cb_script_changed), entry);
 
   /* append to list */
-  if(!Jumanji.Bindings.bcmdlist)
-    Jumanji.Bindings.bcmdlist = entry;
+  if(!Jumanji.Global.scripts)
+    Jumanji.Global.scripts = entry;
 
-  if(bc)
-    bc->next = entry;
+  if(sl)
+    sl->next = entry;
 
   return TRUE;
 }
 
 gboolean
-cmd_bookmark(int argc, char** argv)
+cmd_search_engine(int argc, char** argv)
 {
-  char* bookmark = g_strdup(webkit_web_view_get_uri(GET_CURRENT_TAB()));
+  if(argc < 2)
+    return TRUE;
 
-  /* at first we verify that bookmark (without tag) isn't already in the list */
-  unsigned int bookmark_length = strlen(bookmark);
-  for(GList* l = Jumanji.Global.bookmarks; l; l = g_list_next(l))
+  char* name = argv[0];
+  char* uri  = argv[1];
+
+  /* search for existing search engine to overwrite it */
+  SearchEngineList* se = Jumanji.Global.search_engines;
+  while(se && se->next != NULL)
   {
-    if(!strncmp(bookmark, (char*) l->data, bookmark_length))
+    if(!strcmp(se->name, name))
     {
-      /* we remove the former bookmark so tags will be updated by the new ones */
-      g_free(l->data);
-      Jumanji.Global.bookmarks = g_list_delete_link(Jumanji.Global.bookmarks, l);
-      break;
+      se->uri = uri;
+      return TRUE;
     }
-  }
-
-  /* I am sure argv end with NULL since it was generate by g_strsplit()
-   * in cb_inputbar_activate.
-   * Even if I know (argv[argc] == NULL) I test it since apply g_strjoinv
-   * to a non NULL terminated array would be VERY problematic.
-   * So I protect cmd_bookmark from bad cb_inputbar_activate modification.
-   */
-
-  /* if there is tags we add it to the bookmark string
-   * -> append it to the bookmark
-   */
-  if(argc >= 1 && argv[argc] == NULL)
-  {
-    char* tags = g_strjoinv(" ", argv);
-    char* bookmark_temp = bookmark;
-    bookmark = g_strjoin(" ", bookmark, tags, NULL);
 
-    g_free(bookmark_temp);
-    g_free(tags);
+    se = se->next;
   }
 
-  Jumanji.Global.bookmarks = g_list_append(Jumanji.Global.bookmarks, bookmark);
+  /* create new engine */
+  SearchEngineList* entry = malloc(sizeof(SearchEngineList));
+  if(!entry)
+    out_of_memory();
 
-  return TRUE;
-}
+  entry->name = name;
+  entry->uri  = uri;
+  entry->next = NULL;
 
-gboolean
-cmd_forward(int UNUSED(argc), char** UNUSED(argv))
-{
-  Argument argument;
-  argument.n = NEXT;
-  sc_nav_history(&argument);
+  /* append to list */
+  if(!Jumanji.Global.search_engines)
+    Jumanji.Global.search_engines = entry;
+
+  if(se)
+    se->next = entry;
 
   return TRUE;
 }
 
 gboolean
-cmd_map(int argc, char** argv)
+cmd_set(int argc, char** argv)
 {
-  if(argc < 2)
+  if(argc <= 0)
     return TRUE;
 
-  char* ks = argv[0];
+  /* get webkit settings */
+  WebKitWebSettings* browser_settings;
+  if(Jumanji.Tabs.current)
+    browser_settings = webkit_web_view_get_settings(GET_CURRENT_TAB());
+  else
+    browser_settings = Jumanji.Global.browser_settings;
 
-  /* search for the right shortcut function */
-  int sc_id = -1;
+  WebKitWebView* current_wv = NULL;
+  if(Jumanji.Tabs.current)
+    current_wv = GET_CURRENT_TAB();
 
-  for(unsigned int sc_c = 0; sc_c < LENGTH(function_names); sc_c++)
+  for(unsigned int i = 0; i < LENGTH(settings); i++)
   {
-    if(!strcmp(argv[1], function_names[sc_c].name) && function_names[sc_c].sc)
+    if(!strcmp(argv[0], settings[i].name))
     {
-      sc_id = sc_c;
-      break;
-    }
-  }
+      /* check var type */
+      if(settings[i].type == 'b')
+      {
+        gboolean value = TRUE;
 
-  if(sc_id == -1)
-  {
-    notify(WARNING, "No such shortcut function exists");
-    return FALSE;
-  }
+        if(argv[1])
+        {
+          if(!strcmp(argv[1], "false") || !strcmp(argv[1], "0"))
+            value = FALSE;
+          else
+            value = TRUE;
+        }
 
-  /* parse modifier and key */
-  unsigned int mask = 0;
-  unsigned int key  = 0;
-  int keyl = strlen(ks);
-  int mode = NORMAL;
+        if(settings[i].variable)
+        {
+          gboolean *x = (gboolean*) (settings[i].variable);
+          *x = !(*x);
 
-  // single key (e.g.: g)
-  if(keyl == 1)
-    key = ks[0];
+          if(argv[1])
+            *x = value;
+        }
 
-  // modifier and key (e.g.: <S-g>
-  // special key or modifier and key/special key (e.g.: <S-g>, <Space>)
+        /* check browser settings */
+        if(settings[i].webkitvar)
+          g_object_set(G_OBJECT(browser_settings), settings[i].webkitvar, value, NULL);
+        if(settings[i].webkitview)
+          g_object_set(G_OBJECT(current_wv), settings[i].webkitvar, value, NULL);
+      }
+      else if(settings[i].type == 'i')
+      {
+        if(argc != 2)
+          return TRUE;
 
-  else if(keyl >= 3 && ks[0] == '<' && ks[keyl-1] == '>')
-  {
-    char* specialkey = NULL;
+        int id = -1;
+        for(unsigned int arg_c = 0; arg_c < LENGTH(argument_names); arg_c++)
+        {
+          if(!strcmp(argv[1], argument_names[arg_c].name))
+          {
+            id = argument_names[arg_c].argument;
+            break;
+          }
+        }
 
-    /* check for modifier */
-    if(keyl >= 5 && ks[2] == '-')
-    {
-      /* evaluate modifier */
-      switch(ks[1])
+        if(id == -1)
+          id = atoi(argv[1]);
+
+        if(settings[i].variable)
+        {
+          int *x = (int*) (settings[i].variable);
+          *x = id;
+        }
+
+        /* check browser settings */
+        if(settings[i].webkitvar)
+          g_object_set(G_OBJECT(browser_settings), settings[i].webkitvar, id, NULL);
+      }
+      else if(settings[i].type == 'f')
       {
-        case 'S':
-          mask = GDK_SHIFT_MASK;
-          break;
-        case 'C':
-          mask = GDK_CONTROL_MASK;
-          break;
-        case 'W':
-          mask = GDK_SUPER_MASK | GDK_MOD4_MASK;
-          break;
-        case 'A':
-          mask = GDK_MOD1_MASK;
-          break;
+        if(argc != 2)
+          return TRUE;
+
+        float value = atof(argv[1]);
+
+        if(settings[i].variable)
+        {
+          float *x = (float*) (settings[i].variable);
+          *x = value;
+        }
+
+        /* check browser settings */
+        if(settings[i].webkitvar)
+          g_object_set(G_OBJECT(browser_settings), settings[i].webkitvar, value, NULL);
+      }
+      else if(settings[i].type == 's')
+      {
+        if(argc < 2)
+          return TRUE;
+
+        /* assembly the arguments back to one string */
+        gchar* s = g_strjoinv(" ", &(argv[1]));
+
+        if(settings[i].variable)
+        {
+          char **x = (char**) settings[i].variable;
+          *x = s;
+        }
+
+        /* check browser settings */
+        if(settings[i].webkitvar)
+          g_object_set(G_OBJECT(browser_settings), settings[i].webkitvar, s, NULL);
+
+        // a memory leak can append here
       }
+      else if(settings[i].type == 'c')
+      {
+        if(argc != 2)
+          return TRUE;
+
+        char value = argv[1][0];
+
+        if(settings[i].variable)
+        {
+          char *x = (char*) (settings[i].variable);
+          *x = value;
+        }
 
-      /* no valid modifier */
-      if(!mask)
-      {
-        notify(WARNING, "No valid modifier given.");
-        return FALSE;
+        /* check browser settings */
+        if(settings[i].webkitvar)
+          g_object_set(G_OBJECT(browser_settings), settings[i].webkitvar, value, NULL);
       }
 
-      /* modifier and special key */
-      if(keyl > 5)
-        specialkey = g_strndup(ks + 3, keyl - 4);
-      else
-        key = ks[3];
-    }
-    else
-      specialkey = ks;
+      /* the cache limit applies immediately */
+      if(settings[i].variable == &cache_size && Jumanji.Soup.cache)
+        soup_cache_set_max_size(Jumanji.Soup.cache, (guint) CLAMP(cache_size, 0, 4095) * 1024 * 1024);
 
-    /* search special key */
-    for(unsigned int g_c = 0; specialkey && g_c < LENGTH(gdk_keys); g_c++)
-    {
-      if(!strcmp(specialkey, gdk_keys[g_c].identifier))
-      {
-        key = gdk_keys[g_c].key;
-        break;
-      }
-    }
+      if(settings[i].variable == &offline)
+        mark_dirty(DIRTY_URI);
 
-    if(specialkey)
-      g_free(specialkey);
+      /* reload */
+      if(settings[i].reload && Jumanji.Batch.depth)
+        Jumanji.Batch.reload = TRUE;
+      else if(settings[i].reload && Jumanji.UI.view)
+        if(Jumanji.Tabs.current)
+          webkit_web_view_reload(GET_CURRENT_TAB());
+    }
   }
 
-  if(!key)
+  /* check specific settings */
+  if(Jumanji.UI.statusbar)
   {
-    notify(WARNING, "No valid key binding given.");
-    return FALSE;
+    if(show_statusbar)
+      gtk_widget_show(GTK_WIDGET(Jumanji.UI.statusbar));
+    else
+      gtk_widget_hide(GTK_WIDGET(Jumanji.UI.statusbar));
   }
 
-  /* parse argument */
-  Argument arg = {0, 0};
-
-  if(argc >= 3)
+  if(Jumanji.UI.tabbar)
   {
-    int arg_id = -1;
-
-    /* compare argument with given argument names... */
-    for(unsigned int arg_c = 0; arg_c < LENGTH(argument_names); arg_c++)
-    {
-      if(!strcmp(argv[2], argument_names[arg_c].name))
-      {
-        arg_id = argument_names[arg_c].argument;
-        break;
-      }
-    }
-
-    /* if not, save it do .data */
-    if(arg_id == -1)
-      arg.data = argv[2];
+    if(show_tabbar)
+      gtk_widget_show(GTK_WIDGET(Jumanji.UI.tabbar));
     else
-      arg.n = arg_id;
+      gtk_widget_hide(GTK_WIDGET(Jumanji.UI.tabbar));
   }
 
-  /* parse mode */
-  if(argc >= 4)
+  update_status();
+  return TRUE;
+}
+
+gboolean
+cmd_source(int argc, char** argv)
+{
+  if(argc < 1)
+    return TRUE;
+
+  char* path    = argv[0];
+  char* content = read_file(path);
+
+  if(!content)
   {
-    for(unsigned int mode_c = 0; mode_c < LENGTH(mode_names); mode_c++)
-    {
-      if(!strcmp(argv[3], mode_names[mode_c].name))
-      {
-        mode = mode_names[mode_c].mode;
-        break;
-      }
-    }
+    gchar* message = g_strdup_printf("Could not open or read file '%s'", path);
+    notify(ERROR, message);
+    g_free(message);
+    return FALSE;
   }
 
-  /* search for existing binding to overwrite it */
-  ShortcutList* sc = Jumanji.Bindings.sclist;
-  while(sc && sc->next != NULL)
-  {
-    if(
-       sc->element.key == key
-       && sc->element.mask == mask
-       && sc->element.mode == mode
-      )
-    {
-      sc->element.function = function_names[sc_id].sc;
-      sc->element.argument = arg;
-      return TRUE;
-    }
+  gchar** lines = g_strsplit(content, "\n", -1);
+  g_free(content);
 
-    sc = sc->next;
-  }
+  /* execute all commands at once and update the ui afterwards */
+  batch_begin();
 
-  /* create new entry */
-  ShortcutList* entry = malloc(sizeof(ShortcutList));
-  if(!entry)
-    out_of_memory();
+  for(int i = 0; lines[i]; i++)
+    run_command(lines[i]);
 
-  entry->element.mask     = mask;
-  entry->element.key      = key;
-  entry->element.function = function_names[sc_id].sc;
-  entry->element.mode     = mode;
-  entry->element.argument = arg;
-  entry->next             = NULL;
+  batch_end();
 
-  /* append to list */
-  if(!Jumanji.Bindings.sclist)
-    Jumanji.Bindings.sclist = entry;
+  g_strfreev(lines);
 
-  if(sc)
-    sc->next = entry;
+  return TRUE;
+}
 
+gboolean
+cmd_stop(int UNUSED(argc), char** UNUSED(argv))
+{
+  webkit_web_view_stop_loading(GET_CURRENT_TAB());
   return TRUE;
 }
 
 gboolean
-cmd_open(int argc, char** argv)
+cmd_tabopen(int argc, char** argv)
 {
   if(argc <= 0)
     return TRUE;
 
-  if(argv[argc] != NULL)
-    return TRUE;
+  int i;
+  GString *uri = g_string_new("");
 
-  char* uri = g_strjoinv(" ", argv);
+  for(i = 0; i < argc; i++)
+  {
+    if(i != 0)
+      uri = g_string_append_c(uri, ' ');
 
-  open_uri(GET_CURRENT_TAB(), uri);
-  g_free(uri);
+    uri = g_string_append(uri, argv[i]);
+  }
+
+  create_tab(uri->str, FALSE);
+
+  g_string_free(uri, FALSE);
 
   return TRUE;
 }
 
 gboolean
-cmd_print(int UNUSED(argc), char** UNUSED(argv))
+cmd_winopen(int argc, char** argv)
 {
-  WebKitWebFrame* frame = webkit_web_view_get_main_frame(GET_CURRENT_TAB());
+  if(argc <= 0)
+    return TRUE;
 
-  if(!frame)
-    return FALSE;
+  int i;
+  GString *uri = g_string_new("");
 
-  webkit_web_frame_print(frame);
+  for(i = 0; i < argc; i++)
+  {
+    if(i != 0)
+      uri = g_string_append_c(uri, ' ');
+
+    uri = g_string_append(uri, argv[i]);
+  }
+
+  new_window(uri->str);
+
+  g_string_free(uri, FALSE);
 
   return TRUE;
 }
 
 gboolean
-cmd_quit(int UNUSED(argc), char** UNUSED(argv))
+cmd_write(int UNUSED(argc), char** UNUSED(argv))
 {
-  sc_close_tab(NULL);
+  /* save bookmarks */
+  GString *bookmark_list = g_string_new("");
+
+  for(GList* l = Jumanji.Global.bookmarks; l; l = g_list_next(l))
+  {
+    char* bookmark = g_strconcat((char*) l->data, "\n", NULL);
+    bookmark_list = g_string_append(bookmark_list, bookmark);
+    g_free(bookmark);
+  }
+
+  char* bookmark_file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_BOOKMARKS, NULL);
+  g_file_set_contents(bookmark_file, bookmark_list->str, -1, NULL);
+
+  g_free(bookmark_file);
+  g_string_free(bookmark_list, TRUE);
+
+  /* save history */
+  GString *history_list = g_string_new("");
+
+  int h_counter = 0;
+  for(GList* h = Jumanji.Global.history; h && (!history_limit || h_counter < history_limit); h = g_list_next(h))
+  {
+    char* uri = g_strconcat((char*) h->data, "\n", NULL);
+    history_list = g_string_append(history_list, uri);
+    g_free(uri);
+
+    h_counter += 1;
+  }
+
+  char* history_file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_HISTORY, NULL);
+  g_file_set_contents(history_file, history_list->str, -1, NULL);
+
+  g_free(history_file);
+  g_string_free(history_list, TRUE);
+
+  if(!default_session_name)
+    return TRUE;
+
+  /* save session */
+  sessionsave(default_session_name);
+
+  GString* session_list = g_string_new("");
+
+  for(GList* se_list = Jumanji.Global.sessions; se_list; se_list = g_list_next(se_list))
+  {
+    Session* se = se_list->data;
+
+    gchar* session_lines = g_strconcat(se->name, "\n", se->uris, "\n", NULL);
+    session_list = g_string_append(session_list, session_lines);
+
+    g_free(session_lines);
+  }
+
+  gchar* session_file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_SESSIONS, NULL);
+  g_file_set_contents(session_file, session_list->str, -1, NULL);
+
+  g_free(session_file);
+  g_string_free(session_list, TRUE);
+
   return TRUE;
 }
 
 gboolean
-cmd_quitall(int UNUSED(argc), char** UNUSED(argv))
+cmd_sessionsave(int argc, char** argv)
 {
-  cb_destroy(NULL, NULL);
-  return TRUE;
+  if(argc <= 0 || argv[argc] != NULL)
+    return FALSE;
+
+  gchar* session_name   = g_strjoinv(" ", argv);
+
+  gboolean to_return = sessionsave(session_name);
+
+  g_free(session_name);
+
+  return to_return;
 }
 
 gboolean
-cmd_reload(int UNUSED(argc), char** UNUSED(argv))
+cmd_sessionswitch(int argc, char** argv)
 {
-  Argument argument = {0, 0};
-  sc_reload(&argument);
+  if(argc <= 0 || argv[argc] != NULL)
+    return FALSE;
 
-  return TRUE;
-}
+  gchar* session_name   = g_strjoinv(" ", argv);
 
-gboolean
-cmd_reload_all(int UNUSED(argc), char** UNUSED(argv))
-{
-  int number_of_tabs = gtk_notebook_get_n_pages(Jumanji.UI.view);
-  int i;
+  gboolean to_return = sessionswitch(session_name);
 
-  for(i = 0; i < number_of_tabs; i++)
-    webkit_web_view_reload_bypass_cache(GET_NTH_TAB(i));
+  g_free(session_name);
 
-  return TRUE;
+  return to_return;
 }
 
 gboolean
-cmd_saveas(int argc, char** argv)
+cmd_sessionload(int argc, char** argv)
 {
-  char* filename;
-
-  if(argc > 0)
-    filename = argv[0];
-  else
-    filename = (char*) webkit_web_view_get_title(GET_CURRENT_TAB());
+  if(argc <= 0 || argv[argc] != NULL)
+    return FALSE;
 
-  char* uri       = (char*) webkit_web_view_get_uri(GET_CURRENT_TAB());
-  char* file      = g_strconcat(download_dir, filename ? filename : uri, NULL);
-  char* command   = g_strdup_printf(download_command, uri, file);
+  gchar* session_name = g_strjoinv(" ", argv);
 
-  g_spawn_command_line_async(command, NULL);
+  gboolean to_return = sessionload(session_name);
 
-  g_free(command);
-  g_free(file);
+  g_free(session_name);
 
-  return TRUE;
+  return to_return;
 }
 
-gboolean
-cmd_script(int argc, char** argv)
+/* completion command implementation */
+Completion*
+cc_open(char* input)
 {
-  if(argc < 1)
-    return TRUE;
+  Completion* completion = completion_init();
 
-  char* path    = argv[0];
-  char* content = read_file(path);
+  /* search engines */
+  CompletionGroup* search_engines = completion_group_create("Search engines");
+  SearchEngineList* se = Jumanji.Global.search_engines;
 
-  if(!content)
+  /*if(se)*/
+    completion_add_group(completion, search_engines);
+
+  while(se)
   {
-    gchar* message = g_strdup_printf("Could not open or read file '%s'", path);
-    notify(ERROR, message);
-    g_free(message);
-    return FALSE;
+    if(!strncmp(se->name, input, strlen(input)))
+      completion_group_add_element(search_engines, se->name, NULL);
+    se = se->next;
   }
 
-  /* search for existing script to overwrite or reread it */
-  ScriptList* sl = Jumanji.Global.scripts;
-  while(sl && sl->next != NULL)
+  /* we make bookmark and history completion case insensitive */
+  gchar* lowercase_input = g_utf8_strdown(input, -1);
+
+  /* bookmarks */
+  if(Jumanji.Global.bookmarks)
   {
-    if(!strcmp(sl->path, path))
+    CompletionGroup* bookmarks = completion_group_create("Bookmarks");
+    completion_add_group(completion, bookmarks);
+
+    for(GList* l = Jumanji.Global.bookmarks; l; l = g_list_next(l))
     {
-      sl->path    = path;
-      sl->content = content;
-      return TRUE;
-    }
+      char* bookmark = (char*) l->data;
+      gchar* lowercase_bookmark = g_utf8_strdown(bookmark, -1);
 
-    sl = sl->next;
+      /* case insensitive search */
+      if(strstr(lowercase_bookmark, lowercase_input))
+        completion_group_add_element(bookmarks, bookmark, NULL);
+
+      g_free(lowercase_bookmark);
+    }
   }
 
-  /* load new script */
-  ScriptList* entry = malloc(sizeof(ScriptList));
-  if(!entry)
-    out_of_memory();
+  /* history */
+  if(Jumanji.Global.history)
+  {
+    CompletionGroup* history = completion_group_create("History");
+    completion_add_group(completion, history);
 
-  entry->path    = path;
-  entry->content = content;
-  entry->next    = NULL;
+    for(GList* h = Jumanji.Global.history; h; h = g_list_next(h))
+    {
+      char* uri = (char*) h->data;
+      gchar* lowercase_uri = g_utf8_strdown(uri, -1);
 
-  /* append to list */
-  if(!Jumanji.Global.scripts)
-    Jumanji.Global.scripts = entry;
+      /* case insensitive search */
+      if(strstr(lowercase_uri, lowercase_input))
+        completion_group_add_element(history, uri, NULL);
 
-  if(sl)
-    sl->next = entry;
+      g_free(lowercase_uri);
+    }
+  }
 
-  return TRUE;
+  g_free(lowercase_input);
+
+  return completion;
 }
 
-gboolean
-cmd_search_engine(int argc, char** argv)
+Completion*
+cc_session(char* input)
 {
-  if(argc < 2)
-    return TRUE;
+  Completion* completion = completion_init();
+  CompletionGroup* group = completion_group_create(NULL);
 
-  char* name = argv[0];
-  char* uri  = argv[1];
+  completion_add_group(completion, group);
 
-  /* search for existing search engine to overwrite it */
-  SearchEngineList* se = Jumanji.Global.search_engines;
-  while(se && se->next != NULL)
+  for(GList* l = Jumanji.Global.sessions; l; l = g_list_next(l))
   {
-    if(!strcmp(se->name, name))
-    {
-      se->uri = uri;
-      return TRUE;
-    }
+    Session* se = l->data;
 
-    se = se->next;
+    if(strstr(se->name, input))
+      completion_group_add_element(group, se->name, NULL);
   }
 
-  /* create new engine */
-  SearchEngineList* entry = malloc(sizeof(SearchEngineList));
-  if(!entry)
-    out_of_memory();
-
-  entry->name = name;
-  entry->uri  = uri;
-  entry->next = NULL;
-
-  /* append to list */
-  if(!Jumanji.Global.search_engines)
-    Jumanji.Global.search_engines = entry;
-
-  if(se)
-    se->next = entry;
-
-  return TRUE;
+  return completion;
 }
 
-gboolean
-cmd_set(int argc, char** argv)
+Completion*
+cc_set(char* input)
 {
-  if(argc <= 0)
-    return TRUE;
+  Completion* completion = completion_init();
+  CompletionGroup* group = completion_group_create(NULL);
 
-  /* get webkit settings */
-  WebKitWebSettings* browser_settings;
-  if(Jumanji.UI.view && gtk_notebook_get_current_page(Jumanji.UI.view) >= 0)
-    browser_settings = webkit_web_view_get_settings(GET_CURRENT_TAB());
-  else
-    browser_settings = Jumanji.Global.browser_settings;
+  completion_add_group(completion, group);
 
-  WebKitWebView* current_wv = NULL;
-  if(Jumanji.UI.view && gtk_notebook_get_current_page(Jumanji.UI.view) >= 0)
-    current_wv = GET_CURRENT_TAB();
+  unsigned int input_length = input ? strlen(input) : 0;
 
   for(unsigned int i = 0; i < LENGTH(settings); i++)
   {
-    if(!strcmp(argv[0], settings[i].name))
+    if( (input_length <= strlen(settings[i].name)) &&
+        !strncmp(input, settings[i].name, input_length) &&
+        !settings[i].init_only)
     {
-      /* check var type */
-      if(settings[i].type == 'b')
-      {
-        gboolean value = TRUE;
-
-        if(argv[1])
-        {
-          if(!strcmp(argv[1], "false") || !strcmp(argv[1], "0"))
-            value = FALSE;
-          else
-            value = TRUE;
-        }
-
-        if(settings[i].variable)
-        {
-          gboolean *x = (gboolean*) (settings[i].variable);
-          *x = !(*x);
-
-          if(argv[1])
-            *x = value;
-        }
-
-        /* check browser settings */
-        if(settings[i].webkitvar)
-          g_object_set(G_OBJECT(browser_settings), settings[i].webkitvar, value, NULL);
-        if(settings[i].webkitview)
-          g_object_set(G_OBJECT(current_wv), settings[i].webkitvar, value, NULL);
-      }
-      else if(settings[i].type == 'i')
-      {
-        if(argc != 2)
-          return TRUE;
+      completion_group_add_element(group, settings[i].name, settings[i].description);
+    }
+  }
 
-        int id = -1;
-        for(unsigned int arg_c = 0; arg_c < LENGTH(argument_names); arg_c++)
-        {
-          if(!strcmp(argv[1], argument_names[arg_c].name))
-          {
-            id = argument_names[arg_c].argument;
-            break;
-          }
-        }
+  return completion;
+}
 
-        if(id == -1)
-          id = atoi(argv[1]);
+/* buffer command implementation */
+void
+bcmd_close_tab(char* UNUSED(buffer), Argument* argument)
+{
+  sc_close_tab(argument);
+}
 
-        if(settings[i].variable)
-        {
-          int *x = (int*) (settings[i].variable);
-          *x = id;
-        }
+void
+bcmd_go_home(char* UNUSED(buffer), Argument* argument)
+{
+  if(argument->n == NEW_TAB)
+    create_tab(home_page, FALSE);
+  else
+    open_uri(GET_CURRENT_TAB(), home_page);
+}
 
-        /* check browser settings */
-        if(settings[i].webkitvar)
-          g_object_set(G_OBJECT(browser_settings), settings[i].webkitvar, id, NULL);
-      }
-      else if(settings[i].type == 'f')
-      {
-        if(argc != 2)
-          return TRUE;
+void
+bcmd_go_parent(char* buffer, Argument* UNUSED(argument))
+{
+  char* current_uri = (char*) webkit_web_view_get_uri(GET_CURRENT_TAB());
+  if(!current_uri)
+    return;
 
-        float value = atof(argv[1]);
+  /* calcuate root */
+  int   o = g_str_has_prefix(current_uri, "https://") ? 8 : 7;
+  int  rl = 0;
+  char* r = current_uri + o;
 
-        if(settings[i].variable)
-        {
-          float *x = (float*) (settings[i].variable);
-          *x = value;
-        }
+  while(r && *r != '/')
+    rl++, r++;
 
-        /* check browser settings */
-        if(settings[i].webkitvar)
-          g_object_set(G_OBJECT(browser_settings), settings[i].webkitvar, value, NULL);
-      }
-      else if(settings[i].type == 's')
-      {
-        if(argc < 2)
-          return TRUE;
+  char* root = g_strndup(current_uri, o + rl + 1);
 
-        /* assembly the arguments back to one string */
-        gchar* s = g_strjoinv(" ", &(argv[1]));
+  /* go to the root of the website */
+  if(!strcmp(buffer, "gU"))
+    open_uri(GET_CURRENT_TAB(), root);
+  else
+  {
+    int count = Jumanji.Global.count;
 
-        if(settings[i].variable)
-        {
-          char **x = (char**) settings[i].variable;
-          *x = s;
-        }
+    if(count <= 0)
+      count = 1;
 
-        /* check browser settings */
-        if(settings[i].webkitvar)
-          g_object_set(G_OBJECT(browser_settings), settings[i].webkitvar, s, NULL);
+    char* directories = g_strndup(current_uri + strlen(root), strlen(current_uri) - strlen(root));
 
-        // a memory leak can append here
-      }
-      else if(settings[i].type == 'c')
-      {
-        if(argc != 2)
-          return TRUE;
+    if(strlen(directories) <= 0)
+      open_uri(GET_CURRENT_TAB(), root);
+    else
+    {
+      gchar **tokens = g_strsplit(directories, "/", -1);
+      int     length = g_strv_length(tokens) - 1;
 
-        char value = argv[1][0];
+      GString* tmp = g_string_new("");
 
-        if(settings[i].variable)
-        {
-          char *x = (char*) (settings[i].variable);
-          *x = value;
-        }
+      int i;
+      for(i = 0; i < length - count; i++)
+        g_string_append(tmp, tokens[i]);
 
-        /* check browser settings */
-        if(settings[i].webkitvar)
-          g_object_set(G_OBJECT(browser_settings), settings[i].webkitvar, value, NULL);
-      }
+      char* new_uri = g_strconcat(root, tmp->str, NULL);
+      open_uri(GET_CURRENT_TAB(), new_uri);
 
-      /* reload */
-      if(settings[i].reload && Jumanji.UI.view)
-        if(gtk_notebook_get_current_page(Jumanji.UI.view) >= 0)
-          webkit_web_view_reload(GET_CURRENT_TAB());
+      g_free(new_uri);
+      g_string_free(tmp, TRUE);
+      g_strfreev(tokens);
     }
-  }
 
-  /* check specific settings */
-  if(Jumanji.UI.statusbar)
-  {
-    if(show_statusbar)
-      gtk_widget_show(GTK_WIDGET(Jumanji.UI.statusbar));
-    else
-      gtk_widget_hide(GTK_WIDGET(Jumanji.UI.statusbar));
+    g_free(directories);
   }
 
-  if(Jumanji.UI.tabbar)
+  g_free(root);
+}
+
+void
+bcmd_nav_history(char* UNUSED(buffer), Argument* argument)
+{
+  sc_nav_history(argument);
+}
+
+void
+bcmd_nav_tabs(char* buffer, Argument* argument)
+{
+  int current_tab     = Jumanji.Tabs.current->position;
+  int number_of_tabs  = (int) Jumanji.Tabs.list->len;
+  int count           = Jumanji.Global.count ? Jumanji.Global.count : 1;
+  int step            = count % number_of_tabs;
+
+  if(argument->n == PREVIOUS)
+    step = -step;
+
+  int new_tab = (current_tab + step + number_of_tabs) % number_of_tabs;
+
+  if(argument->n == SPECIFIC)
   {
-    if(show_tabbar)
-      gtk_widget_show(GTK_WIDGET(Jumanji.UI.tabbar));
+    /* atoi stops at the first non digit character */
+    if(argument->data)
+      new_tab = atoi(argument->data) - 1;
     else
-      gtk_widget_hide(GTK_WIDGET(Jumanji.UI.tabbar));
+      new_tab = (buffer ? atoi(buffer) : count) - 1;
   }
 
+  gtk_notebook_set_current_page(Jumanji.UI.view, new_tab);
+  gtk_widget_grab_focus(GTK_WIDGET(GET_CURRENT_TAB_WIDGET()));
+
   update_status();
-  return TRUE;
 }
 
-gboolean
-cmd_stop(int UNUSED(argc), char** UNUSED(argv))
+void
+bcmd_paste(char* UNUSED(buffer), Argument* argument)
 {
-  webkit_web_view_stop_loading(GET_CURRENT_TAB());
-  return TRUE;
+  sc_paste(argument);
 }
 
-gboolean
-cmd_tabopen(int argc, char** argv)
+void
+bcmd_quit(char* UNUSED(buffer), Argument* UNUSED(argument))
 {
-  if(argc <= 0)
-    return TRUE;
-
-  int i;
-  GString *uri = g_string_new("");
+  cmd_quitall(0, NULL);
+}
 
-  for(i = 0; i < argc; i++)
+void
+bcmd_scroll(char* UNUSED(buffer), Argument* argument)
+{
+  if(argument->n == TOP || argument->n == BOTTOM)
   {
-    if(i != 0)
-      uri = g_string_append_c(uri, ' ');
-
-    uri = g_string_append(uri, argv[i]);
+    sc_scroll(argument);
+    return;
   }
 
-  create_tab(uri->str, FALSE);
+  GtkAdjustment* adjustment = gtk_scrolled_window_get_vadjustment(GET_CURRENT_TAB_WIDGET());
 
-  g_string_free(uri, FALSE);
+  gdouble view_size = gtk_adjustment_get_page_size(adjustment);
+  gdouble max       = gtk_adjustment_get_upper(adjustment) - view_size;
 
-  return TRUE;
+  int number     = Jumanji.Global.count;
+  int percentage = (number < 0) ? 0 : (number > 100) ? 100 : number;
+  gdouble value  = (max / 100.0f) * (float) percentage;
+
+  gtk_adjustment_set_value(adjustment, value);
 }
 
-gboolean
-cmd_winopen(int argc, char** argv)
+void
+bcmd_spawn(char* UNUSED(buffer), Argument* argument)
 {
-  if(argc <= 0)
-    return TRUE;
+  char* uri     = (char*) webkit_web_view_get_uri(GET_CURRENT_TAB());
+  char* command = g_strdup_printf(argument->data, uri);
 
-  int i;
-  GString *uri = g_string_new("");
+  g_spawn_command_line_async(command, NULL);
 
-  for(i = 0; i < argc; i++)
+  g_free(command);
+}
+
+void
+bcmd_toggle_sourcecode(char* UNUSED(buffer), Argument* argument)
+{
+  if(argument->n == OPEN_EXTERNAL)
   {
-    if(i != 0)
-      uri = g_string_append_c(uri, ' ');
+    gchar* uri    = (gchar*) webkit_web_view_get_uri(GET_CURRENT_TAB());
+    char* command = g_strdup_printf(spawn_editor, uri);
 
-    uri = g_string_append(uri, argv[i]);
-  }
+    g_spawn_command_line_async(command, NULL);
 
-  new_window(uri->str);
+    g_free(command);
+  }
+  else
+    sc_toggle_sourcecode(argument);
+}
 
-  g_string_free(uri, FALSE);
+void
+bcmd_zoom(char* UNUSED(buffer), Argument* argument)
+{
+  float zoom_level = webkit_web_view_get_zoom_level(GET_CURRENT_TAB());
+  int   count      = Jumanji.Global.count ? Jumanji.Global.count : 1;
 
-  return TRUE;
+  if(argument->n == ZOOM_IN)
+    webkit_web_view_set_zoom_level(GET_CURRENT_TAB(), zoom_level + count * (float) (zoom_step / 100));
+  else if(argument->n == ZOOM_OUT)
+    webkit_web_view_set_zoom_level(GET_CURRENT_TAB(), zoom_level - count * (float) (zoom_step / 100));
+  else if(argument->n == ZOOM_ORIGINAL)
+    webkit_web_view_set_zoom_level(GET_CURRENT_TAB(), 1.0f);
+  else if(argument->n == SPECIFIC && Jumanji.Global.count)
+    webkit_web_view_set_zoom_level(GET_CURRENT_TAB(), Jumanji.Global.count / 100.0f);
 }
 
+/* search (special)command global variables */
+char* search_item = NULL;
+gboolean search_item_changed = FALSE;
+
+/* special command implementation */
 gboolean
-cmd_write(int UNUSED(argc), char** UNUSED(argv))
+scmd_search(char* input, Argument* argument, gboolean activate)
 {
-  /* save bookmarks */
-  GString *bookmark_list = g_string_new("");
-
-  for(GList* l = Jumanji.Global.bookmarks; l; l = g_list_next(l))
-  {
-    char* bookmark = g_strconcat((char*) l->data, "\n", NULL);
-    bookmark_list = g_string_append(bookmark_list, bookmark);
-    g_free(bookmark);
-  }
+  static guint search_and_highlight_id;
 
-  char* bookmark_file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_BOOKMARKS, NULL);
-  g_file_set_contents(bookmark_file, bookmark_list->str, -1, NULL);
+  if((input && !strlen(input)) || activate)
+    return TRUE;
 
-  g_free(bookmark_file);
-  g_string_free(bookmark_list, TRUE);
+  argument->data = input;
 
-  /* save history */
-  GString *history_list = g_string_new("");
+  g_free(search_item);
+  search_item = g_strdup(input);
+  search_item_changed = TRUE;
 
-  int h_counter = 0;
-  for(GList* h = Jumanji.Global.history; h && (!history_limit || h_counter < history_limit); h = g_list_next(h))
+  gboolean source_removed = FALSE;
+  if(search_and_highlight_id)
   {
-    char* uri = g_strconcat((char*) h->data, "\n", NULL);
-    history_list = g_string_append(history_list, uri);
-    g_free(uri);
-
-    h_counter += 1;
+    source_removed = g_source_remove(search_and_highlight_id);
+    search_and_highlight_id = 0;
   }
 
-  char* history_file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_HISTORY, NULL);
-  g_file_set_contents(history_file, history_list->str, -1, NULL);
+  /* if function was launched by cb_inputbar_activate */
+  if(activate)
+  {
+    if(source_removed)
+      search_and_highlight(argument);
+  }
+  else
+    search_and_highlight_id = g_timeout_add(search_delay, (GSourceFunc)sc_search, argument);
 
-  g_free(history_file);
-  g_string_free(history_list, TRUE);
+  return TRUE;
+}
 
-  if(!default_session_name)
-    return TRUE;
+gboolean
+search_and_highlight(Argument* argument)
+{
+  static WebKitWebView* last_wv = NULL;
 
-  /* save session */
-  sessionsave(default_session_name);
+  if(search_item && !strlen(search_item))
+    return FALSE;
 
-  GString* session_list = g_string_new("");
+  WebKitWebView* current_wv = GET_CURRENT_TAB();
 
-  for(GList* se_list = Jumanji.Global.sessions; se_list; se_list = g_list_next(se_list))
+  if(search_item_changed || last_wv != current_wv)
   {
-    Session* se = se_list->data;
+    webkit_web_view_unmark_text_matches(current_wv);
+    webkit_web_view_mark_text_matches(current_wv, search_item, FALSE, 0);
+    webkit_web_view_set_highlight_text_matches(current_wv, TRUE);
+
+    last_wv = current_wv;
+  }
+
+  gboolean direction = (argument->n == BACKWARD) ? FALSE : TRUE;
+  int      count     = Jumanji.Global.count ? Jumanji.Global.count : 1;
 
-    gchar* session_lines = g_strconcat(se->name, "\n", se->uris, "\n", NULL);
-    session_list = g_string_append(session_list, session_lines);
+  for(int i = 0; i < count; i++)
+    webkit_web_view_search_text(current_wv, search_item, FALSE, direction, TRUE);
 
-    g_free(session_lines);
-  }
+  search_item_changed = FALSE;
+  return FALSE;
+}
 
-  gchar* session_file = g_build_filename(g_get_home_dir(), JUMANJI_DIR, JUMANJI_SESSIONS, NULL);
-  g_file_set_contents(session_file, session_list->str, -1, NULL);
+/* callback implementation */
+UniqueResponse
+cb_app_message_received(UniqueApp* UNUSED(application), gint UNUSED(command), UniqueMessageData* message_data, guint UNUSED(time), gpointer UNUSED(data))
+{
+  if(message_data)
+    create_tab(unique_message_data_get_text(message_data), FALSE);
 
-  g_free(session_file);
-  g_string_free(session_list, TRUE);
+  return UNIQUE_RESPONSE_OK;
+}
 
+gboolean
+cb_blank()
+{
   return TRUE;
 }
 
 gboolean
-cmd_sessionsave(int argc, char** argv)
+cb_blocker_build(gpointer UNUSED(data))
 {
-  if(argc <= 0 || argv[argc] != NULL)
-    return FALSE;
+  Jumanji.Blocker.build_id = 0;
+  Jumanji.Blocker.building = TRUE;
 
-  gchar* session_name   = g_strjoinv(" ", argv);
+  gchar** paths = g_new0(gchar*, Jumanji.Blocker.lists->len + 1);
+  for(unsigned int i = 0; i < Jumanji.Blocker.lists->len; i++)
+    paths[i] = g_strdup(g_ptr_array_index(Jumanji.Blocker.lists, i));
 
-  gboolean to_return = sessionsave(session_name);
+  /* lists are parsed and compiled off the main loop, the thread is never joined */
+  GThread* thread = g_thread_try_new("blocker", blocker_thread, paths, NULL);
 
-  g_free(session_name);
+  if(thread)
+    g_thread_unref(thread);
+  else
+    blocker_thread(paths);
 
-  return to_return;
+  return FALSE;
 }
 
 gboolean
-cmd_sessionswitch(int argc, char** argv)
+cb_blocker_ready(gpointer data)
 {
-  if(argc <= 0 || argv[argc] != NULL)
-    return FALSE;
+  blocker_free(Jumanji.Blocker.filter);
+  Jumanji.Blocker.filter   = (BlockFilter*) data;
+  Jumanji.Blocker.building = FALSE;
 
-  gchar* session_name   = g_strjoinv(" ", argv);
+  if(!data)
+    notify(ERROR, "Could not compile the block lists");
 
-  gboolean to_return = sessionswitch(session_name);
+  if(Jumanji.Blocker.pending)
+  {
+    Jumanji.Blocker.pending  = FALSE;
+    Jumanji.Blocker.build_id = g_idle_add(cb_blocker_build, NULL);
+  }
 
-  g_free(session_name);
+  return FALSE;
+}
 
-  return to_return;
+void
+cb_clipboard_paste(GtkClipboard* UNUSED(clipboard), const gchar* text, gpointer data)
+{
+  if(!text)
+    return;
+
+  if(GPOINTER_TO_INT(data) == NEW_TAB)
+    create_tab((char*) text, FALSE);
+  else if(Jumanji.Tabs.current)
+    open_uri(GET_CURRENT_TAB(), (char*) text);
 }
 
 gboolean
-cmd_sessionload(int argc, char** argv)
+cb_destroy(GtkWidget* UNUSED(widget), gpointer UNUSED(data))
 {
-  if(argc <= 0 || argv[argc] != NULL)
-    return FALSE;
+  /* write bookmarks and history */
+  cmd_write(0, NULL);
 
-  gchar* session_name = g_strjoinv(" ", argv);
+  /* clear bookmarks */
+  GList* list;
+  for(list = Jumanji.Global.bookmarks; list; list = g_list_next(list))
+    free(list->data);
 
-  gboolean to_return = sessionload(session_name);
+  g_list_free(Jumanji.Global.bookmarks);
 
-  g_free(session_name);
+  /* clear history */
+  for(list = Jumanji.Global.history; list; list = g_list_next(list))
+    free(list->data);
 
-  return to_return;
-}
+  g_list_free(Jumanji.Global.history);
+  g_list_free(Jumanji.Global.last_closed);
 
-/* completion command implementation */
-Completion*
-cc_open(char* input)
-{
-  Completion* completion = completion_init();
+  /* clean shortcut list */
+  ShortcutList* sc = Jumanji.Bindings.sclist;
 
-  /* search engines */
-  CompletionGroup* search_engines = completion_group_create("Search engines");
-  SearchEngineList* se = Jumanji.Global.search_engines;
+  while(sc)
+  {
+    ShortcutList* ne = sc->next;
+    free(sc);
+    sc = ne;
+  }
 
-  /*if(se)*/
-    completion_add_group(completion, search_engines);
+  /* clean loaded scripts */
+  SearchEngineList* se = Jumanji.Global.search_engines;
 
   while(se)
   {
-    if(!strncmp(se->name, input, strlen(input)))
-      completion_group_add_element(search_engines, se->name, NULL);
-    se = se->next;
+    SearchEngineList* ne = se->next;
+    free(se);
+    se = ne;
   }
 
-  /* we make bookmark and history completion case insensitive */
-  gchar* lowercase_input = g_utf8_strdown(input, -1);
+  /* clean loaded scripts */
+  ScriptList* sl = Jumanji.Global.scripts;
 
-  /* bookmarks */
-  if(Jumanji.Global.bookmarks)
+  while(sl)
   {
-    CompletionGroup* bookmarks = completion_group_create("Bookmarks");
-    completion_add_group(completion, bookmarks);
+    ScriptList* ne = sl->next;
+    if(sl->content)
+      free(sl->content);
+    if(sl->monitor)
+      g_object_unref(sl->monitor);
+    invalidate_script_source(sl);
+    g_slist_free_full(sl->include, (GDestroyNotify) g_pattern_spec_free);
+    g_slist_free_full(sl->exclude, (GDestroyNotify) g_pattern_spec_free);
+    g_strfreev(sl->patterns);
+    g_free(sl->path);
+    free(sl);
+    sl = ne;
+  }
 
-    for(GList* l = Jumanji.Global.bookmarks; l; l = g_list_next(l))
-    {
-      char* bookmark = (char*) l->data;
-      gchar* lowercase_bookmark = g_utf8_strdown(bookmark, -1);
+  g_hash_table_destroy(Jumanji.Global.profiles);
+  Jumanji.Global.profiles = NULL;
 
-      /* case insensitive search */
-      if(strstr(lowercase_bookmark, lowercase_input))
-        completion_group_add_element(bookmarks, bookmark, NULL);
+  if(Jumanji.Global.bridge)
+    JSClassRelease(Jumanji.Global.bridge);
 
-      g_free(lowercase_bookmark);
-    }
-  }
+  blocker_free(Jumanji.Blocker.filter);
+  g_ptr_array_free(Jumanji.Blocker.lists, TRUE);
 
-  /* history */
-  if(Jumanji.Global.history)
-  {
-    CompletionGroup* history = completion_group_create("History");
-    completion_add_group(completion, history);
+  if(Jumanji.Speculation.hover_id)
+    g_source_remove(Jumanji.Speculation.hover_id);
+  g_hash_table_destroy(Jumanji.Speculation.hosts);
+  g_free(Jumanji.Speculation.hovered);
+  g_free(Jumanji.Speculation.prefetched);
 
-    for(GList* h = Jumanji.Global.history; h; h = g_list_next(h))
-    {
-      char* uri = (char*) h->data;
-      gchar* lowercase_uri = g_utf8_strdown(uri, -1);
+  /* write the pending cookies */
+  if(Jumanji.Cookies.thread)
+    g_thread_join(Jumanji.Cookies.thread);
+  Jumanji.Cookies.thread = NULL;
 
-      /* case insensitive search */
-      if(strstr(lowercase_uri, lowercase_input))
-        completion_group_add_element(history, uri, NULL);
+  if(Jumanji.Cookies.flush_id)
+    g_source_remove(Jumanji.Cookies.flush_id);
+  if(g_hash_table_size(Jumanji.Cookies.dirty))
+    cookies_write(cookies_collect());
 
-      g_free(lowercase_uri);
-    }
+  g_hash_table_destroy(Jumanji.Cookies.domains);
+  g_hash_table_destroy(Jumanji.Cookies.dirty);
+
+  /* write the cache index */
+  if(Jumanji.Soup.cache)
+  {
+    soup_cache_flush(Jumanji.Soup.cache);
+    soup_cache_dump(Jumanji.Soup.cache);
   }
 
-  g_free(lowercase_input);
+  g_hash_table_destroy(Jumanji.Hiding.rules);
+  g_hash_table_destroy(Jumanji.Hiding.sheets);
 
-  return completion;
+  /* clean markers */
+  for(list = Jumanji.Global.markers; list; list = g_list_next(list))
+    free(list->data);
+
+  g_list_free(Jumanji.Global.markers);
+
+  /* clean command history */
+  for(list = Jumanji.Global.command_history; list; list = g_list_next(list))
+    free(list->data);
+
+  g_list_free(Jumanji.Global.command_history);
+
+  /* close record file */
+  if(Jumanji.Replay.record)
+    fclose(Jumanji.Replay.record);
+
+  gtk_main_quit();
+
+  return TRUE;
 }
 
-Completion*
-cc_session(char* input)
+gboolean
+cb_gc_pass(gpointer UNUSED(data))
 {
-  Completion* completion = completion_init();
-  CompletionGroup* group = completion_group_create(NULL);
+  /* the previous pass has not run yet */
+  if(Jumanji.Collector.idle_id)
+    return TRUE;
 
-  completion_add_group(completion, group);
+  Jumanji.Collector.passes++;
 
-  for(GList* l = Jumanji.Global.sessions; l; l = g_list_next(l))
-  {
-    Session* se = l->data;
+  if(Jumanji.Collector.skip > 0)
+    Jumanji.Collector.skip--;
+  else
+    Jumanji.Collector.idle_id = g_idle_add_full(G_PRIORITY_LOW, cb_gc_step, NULL, NULL);
 
-    if(strstr(se->name, input))
-      completion_group_add_element(group, se->name, NULL);
-  }
+  return TRUE;
+}
 
-  return completion;
+gboolean
+cb_gc_step(gpointer UNUSED(data))
+{
+  Jumanji.Collector.idle_id = 0;
+
+  /* all views share one javascript heap, a single collection from the context
+   * of any background tab covers them all */
+  JSContextRef context = NULL;
+
+  for(unsigned int i = 0; i < Jumanji.Tabs.list->len && !context; i++)
+    if(GET_TAB(i) != Jumanji.Tabs.current)
+      context = webkit_web_frame_get_global_context(webkit_web_view_get_main_frame(GET_TAB(i)->view));
+
+  if(!context)
+    return FALSE;
+
+  gint64 before    = resident_memory();
+  gint64 collected = g_get_monotonic_time();
+
+  JSGarbageCollect(context);
+
+  /* a collection can not be interrupted, a long one makes the following
+   * passes leave it out so the time per pass stays within the budget */
+  gint64 duration = g_get_monotonic_time() - collected;
+  if(gc_budget > 0)
+    Jumanji.Collector.skip = duration / ((gint64) gc_budget * 1000);
+
+  profile_script("garbage collection", "gc", collected, FALSE);
+  Jumanji.Collector.collections++;
+  Jumanji.Collector.rss_change += resident_memory() - before;
+
+  return FALSE;
 }
 
-Completion*
-cc_set(char* input)
+gboolean
+cb_hints_rescan(gpointer UNUSED(data))
 {
-  Completion* completion = completion_init();
-  CompletionGroup* group = completion_group_create(NULL);
+  Jumanji.Hints.rescan_id = 0;
 
-  completion_add_group(completion, group);
+  if(Jumanji.Hints.engine && Jumanji.Global.mode == FOLLOW)
+    hints_show();
 
-  unsigned int input_length = input ? strlen(input) : 0;
+  return FALSE;
+}
 
-  for(unsigned int i = 0; i < LENGTH(settings); i++)
+gboolean
+cb_inputbar_kb_pressed(GtkWidget* UNUSED(widget), GdkEventKey* event, gpointer UNUSED(data))
+{
+  guint keyval;
+  GdkModifierType consumed_modifiers;
+
+  gdk_keymap_translate_keyboard_state(
+      Jumanji.Global.keymap, event->hardware_keycode, event->state, event->group, /* inner */
+      &keyval, NULL, NULL, &consumed_modifiers); /* outer */
+
+  /* inputbar shortcuts */
+  for(unsigned int i = 0; i < LENGTH(inputbar_shortcuts); i++)
   {
-    if( (input_length <= strlen(settings[i].name)) &&
-        !strncmp(input, settings[i].name, input_length) &&
-        !settings[i].init_only)
+    if (keyval == inputbar_shortcuts[i].key                                               /* test key  */
+        && (event->state & ~consumed_modifiers & ALL_MASK) == inputbar_shortcuts[i].mask) /* test mask */
     {
-      completion_group_add_element(group, settings[i].name, settings[i].description);
+      inputbar_shortcuts[i].function(&(inputbar_shortcuts[i].argument));
+      return TRUE;
     }
   }
 
-  return completion;
+  return FALSE;
 }
 
-/* buffer command implementation */
 void
-bcmd_close_tab(char* UNUSED(buffer), Argument* argument)
+cb_inputbar_changed(GtkEditable* UNUSED(editable), gpointer UNUSED(data))
 {
-  sc_close_tab(argument);
-}
+  /* special commands */
+  gchar *input  = gtk_editable_get_chars(GTK_EDITABLE(Jumanji.UI.inputbar), 0, -1);
+  char identifier = input[0];
+  for(unsigned int i = 0; i < LENGTH(special_commands); i++)
+  {
+    if((identifier == special_commands[i].identifier) &&
+       (special_commands[i].always == 1))
+    {
+      special_commands[i].function(input + 1, &(special_commands[i].argument), FALSE);
+      g_free(input);
+      return;
+    }
+  }
 
-void
-bcmd_go_home(char* UNUSED(buffer), Argument* argument)
-{
-  if(argument->n == NEW_TAB)
-    create_tab(home_page, FALSE);
-  else
-    open_uri(GET_CURRENT_TAB(), home_page);
+  g_free(input);
+  return;
 }
 
-void
-bcmd_go_parent(char* buffer, Argument* UNUSED(argument))
+gboolean
+cb_inputbar_activate(GtkEntry* entry, gpointer UNUSED(data))
 {
-  char* current_uri = (char*) webkit_web_view_get_uri(GET_CURRENT_TAB());
-  if(!current_uri)
-    return;
-
-  /* calcuate root */
-  int   o = g_str_has_prefix(current_uri, "https://") ? 8 : 7;
-  int  rl = 0;
-  char* r = current_uri + o;
-
-  while(r && *r != '/')
-    rl++, r++;
+  gchar  *input  = gtk_editable_get_chars(GTK_EDITABLE(entry), 0, -1);
+  char identifier = input[0];
+  gboolean  retv = FALSE;
+  gboolean  succ = FALSE;
 
-  char* root = g_strndup(current_uri, o + rl + 1);
+  record_command(input);
 
-  /* go to the root of the website */
-  if(!strcmp(buffer, "gU"))
-    open_uri(GET_CURRENT_TAB(), root);
-  else
+  /* no input */
+  if(strlen(input) <= 1)
   {
-    int count = 1;
+    isc_abort(NULL);
+    g_free(input);
+    return FALSE;
+  }
 
-    if(strlen(buffer) > 2)
-      count = atoi(g_strndup(buffer, strlen(buffer) - 2));
+  /* special commands */
+  for(unsigned int i = 0; i < LENGTH(special_commands); i++)
+  {
+    if(identifier == special_commands[i].identifier)
+    {
+      retv = special_commands[i].function(input + 1, &(special_commands[i].argument), TRUE);
+      if(retv) isc_abort(NULL);
+      gtk_widget_grab_focus(GTK_WIDGET(GET_CURRENT_TAB_WIDGET()));
+      g_free(input);
+      return TRUE;
+    }
+  }
 
-    if(count <= 0)
-      count = 1;
+  gchar **tokens = g_strsplit(input + 1, " ", -1);
+  g_free(input);
+  gchar *command = tokens[0];
+  int     length = g_strv_length(tokens);
 
-    char* directories = g_strndup(current_uri + strlen(root), strlen(current_uri) - strlen(root));
+  /* append input to the command history */
+  if(!private_browsing)
+    Jumanji.Global.command_history = g_list_append(Jumanji.Global.command_history, g_strdup(gtk_entry_get_text(entry)));
 
-    if(strlen(directories) <= 0)
-      open_uri(GET_CURRENT_TAB(), root);
-    else
+  /* search commands */
+  for(unsigned int i = 0; i < LENGTH(commands); i++)
+  {
+    if((g_strcmp0(command, commands[i].command) == 0) ||
+       (g_strcmp0(command, commands[i].abbr)    == 0))
     {
-      gchar **tokens = g_strsplit(directories, "/", -1);
-      int     length = g_strv_length(tokens) - 1;
-
-      GString* tmp = g_string_new("");
-
-      int i;
-      for(i = 0; i < length - count; i++)
-        g_string_append(tmp, tokens[i]);
+      retv = commands[i].function(length - 1, tokens + 1);
+      succ = TRUE;
+      break;
+    }
+  }
 
-      char* new_uri = g_strconcat(root, tmp->str, NULL);
-      open_uri(GET_CURRENT_TAB(), new_uri);
+  if(retv)
+    isc_abort(NULL);
 
-      g_free(new_uri);
-      g_string_free(tmp, TRUE);
-      g_strfreev(tokens);
-    }
+  if(!succ)
+    notify(ERROR, "Unknown command.");
 
-    g_free(directories);
-  }
+  Argument arg = { HIDE, NULL };
+  isc_completion(&arg);
 
-  g_free(root);
-}
+  gtk_widget_grab_focus(GTK_WIDGET(GET_CURRENT_TAB_WIDGET()));
+  g_strfreev(tokens);
 
-void
-bcmd_nav_history(char* UNUSED(buffer), Argument* argument)
-{
-  sc_nav_history(argument);
+  return TRUE;
 }
 
 void
-bcmd_nav_tabs(char* buffer, Argument* argument)
+cb_standin_request(SoupServer* UNUSED(server), SoupMessage* msg, const char* UNUSED(path),
+    GHashTable* UNUSED(query), SoupClientContext* UNUSED(client), gpointer UNUSED(data))
 {
-  int current_tab     = gtk_notebook_get_current_page(Jumanji.UI.view);
-  int number_of_tabs  = gtk_notebook_get_n_pages(Jumanji.UI.view);
-  int step            = 1;
+  /* pages are served from <root>/<host>/<path> */
+  SoupURI* uri = soup_message_get_uri(msg);
 
-  if(argument->n == PREVIOUS)
-    step = -1;
+  if(!uri->host || strstr(uri->path, ".."))
+  {
+    soup_message_set_status(msg, SOUP_STATUS_NOT_FOUND);
+    return;
+  }
 
-  int new_tab = (current_tab + step) % number_of_tabs;
+  char* file = g_build_filename(Jumanji.Replay.root, uri->host, uri->path, NULL);
 
-  if(argument->n == SPECIFIC)
+  if(g_file_test(file, G_FILE_TEST_IS_DIR))
   {
-    if (argument->data)
-      buffer = argument->data;
+    char* index = g_build_filename(file, "index.html", NULL);
+    g_free(file);
+    file = index;
+  }
 
-    int digit_end = 0;
-    while(g_ascii_isdigit(buffer[digit_end]))
-      digit_end = digit_end + 1;
+  char* content = NULL;
+  gsize length  = 0;
 
-    char* number = g_strndup(buffer, digit_end);
-    new_tab      = atoi(number) - 1;
-    g_free(number);
+  if(!g_file_get_contents(file, &content, &length, NULL))
+  {
+    soup_message_set_status(msg, SOUP_STATUS_NOT_FOUND);
+    g_free(file);
+    return;
   }
 
-  gtk_notebook_set_current_page(Jumanji.UI.view, new_tab);
-  gtk_widget_grab_focus(GTK_WIDGET(GET_CURRENT_TAB_WIDGET()));
+  char* content_type = g_content_type_guess(file, (guchar*) content, length, NULL);
+  char* mime_type    = g_content_type_get_mime_type(content_type);
 
-  update_status();
-}
+  soup_message_set_status(msg, SOUP_STATUS_OK);
+  soup_message_set_response(msg, mime_type ? mime_type : "text/html", SOUP_MEMORY_TAKE, content, length);
 
-void
-bcmd_paste(char* UNUSED(buffer), Argument* argument)
-{
-  sc_paste(argument);
+  g_free(mime_type);
+  g_free(content_type);
+  g_free(file);
 }
 
-void
-bcmd_quit(char* UNUSED(buffer), Argument* UNUSED(argument))
+JSValueRef
+cb_js_mode(JSContextRef context, JSObjectRef UNUSED(function), JSObjectRef this, size_t argc,
+    const JSValueRef argv[], JSValueRef* UNUSED(exception))
 {
-  cmd_quitall(0, NULL);
-}
+  Tab* tab = bridge_tab(this);
 
-void
-bcmd_scroll(char* buffer, Argument* argument)
-{
-  if(argument->n == TOP || argument->n == BOTTOM)
-  {
-    sc_scroll(argument);
-    return;
-  }
+  /* only the focused page may change the mode */
+  if(!tab || tab != Jumanji.Tabs.current || argc < 1)
+    return JSValueMakeBoolean(context, FALSE);
 
-  GtkAdjustment* adjustment = gtk_scrolled_window_get_vadjustment(GET_CURRENT_TAB_WIDGET());
+  /* pages must not be able to capture keys with pass through modes */
+  char* name = reference_to_string(context, argv[0]);
+  int   mode = -1;
 
-  gdouble view_size = gtk_adjustment_get_page_size(adjustment);
-  gdouble max       = gtk_adjustment_get_upper(adjustment) - view_size;
+  if(name && !strcmp(name, "normal"))
+    mode = NORMAL;
+  else if(name && !strcmp(name, "insert"))
+    mode = INSERT;
 
-  int number     = atoi(g_strndup(buffer, strlen(buffer) - 1));
-  int percentage = (number < 0) ? 0 : (number > 100) ? 100 : number;
-  gdouble value  = (max / 100.0f) * (float) percentage;
+  g_free(name);
 
-  gtk_adjustment_set_value(adjustment, value);
-}
+  if(mode == -1)
+    return JSValueMakeBoolean(context, FALSE);
 
-void
-bcmd_spawn(char* UNUSED(buffer), Argument* argument)
-{
-  char* uri     = (char*) webkit_web_view_get_uri(GET_CURRENT_TAB());
-  char* command = g_strdup_printf(argument->data, uri);
+  if(Jumanji.Global.mode == FOLLOW && mode != FOLLOW)
+    hints_clear();
 
-  g_spawn_command_line_async(command, NULL);
+  change_mode(mode);
 
-  g_free(command);
+  return JSValueMakeBoolean(context, TRUE);
 }
 
 void
-bcmd_toggle_sourcecode(char* UNUSED(buffer), Argument* argument)
+cb_notebook_switch_page(GtkNotebook* notebook, gpointer UNUSED(page), guint page_num, gpointer UNUSED(data))
 {
-  if(argument->n == OPEN_EXTERNAL)
-  {
-    gchar* uri    = (gchar*) webkit_web_view_get_uri(GET_CURRENT_TAB());
-    char* command = g_strdup_printf(spawn_editor, uri);
+  /* while a page is removed the notebook switches pages before the old one
+   * has left its list, so the number is only valid for the notebook itself */
+  GtkWidget* widget = gtk_notebook_get_nth_page(notebook, page_num);
+  Jumanji.Tabs.current = widget ? (Tab*) g_object_get_data(G_OBJECT(widget), "tab") : NULL;
 
-    g_spawn_command_line_async(command, NULL);
+  /* the hovered link belonged to the previous tab */
+  set_link(NULL);
 
-    g_free(command);
+  /* hints belong to the page they were collected on */
+  if(Jumanji.Hints.tab && Jumanji.Hints.tab != Jumanji.Tabs.current)
+  {
+    hints_clear();
+
+    if(Jumanji.Global.mode == FOLLOW)
+      change_mode(NORMAL);
   }
-  else
-    sc_toggle_sourcecode(argument);
 }
 
 void
-bcmd_zoom(char* buffer, Argument* argument)
+cb_script_changed(GFileMonitor* UNUSED(monitor), GFile* UNUSED(file), GFile* UNUSED(other_file),
+    GFileMonitorEvent event, gpointer data)
 {
-  float zoom_level = webkit_web_view_get_zoom_level(GET_CURRENT_TAB());
+  if(event != G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT && event != G_FILE_MONITOR_EVENT_CREATED)
+    return;
 
-  if(argument->n == ZOOM_IN)
-    webkit_web_view_set_zoom_level(GET_CURRENT_TAB(), zoom_level + (float) (zoom_step / 100));
-  else if(argument->n == ZOOM_OUT)
-    webkit_web_view_set_zoom_level(GET_CURRENT_TAB(), zoom_level - (float) (zoom_step / 100));
-  else if(argument->n == ZOOM_ORIGINAL)
-    webkit_web_view_set_zoom_level(GET_CURRENT_TAB(), 1.0f);
-  else if(argument->n == SPECIFIC)
-  {
-    char* number = g_strndup(buffer, strlen(buffer) - 1);
-    webkit_web_view_set_zoom_level(GET_CURRENT_TAB(), (float) (atoi(number) / 100));
-    g_free(number);
-  }
-}
+  ScriptList* sl = (ScriptList*) data;
+  char* content  = read_file(sl->path);
 
-/* search (special)command global variables */
-char* search_item = NULL;
-gboolean search_item_changed = FALSE;
+  /* keep the old version if the file can not be read */
+  if(!content)
+    return;
 
-/* special command implementation */
-gboolean
-scmd_search(char* input, Argument* argument, gboolean activate)
-{
-  static guint search_and_highlight_id;
+  free(sl->content);
+  sl->content = content;
 
-  if((input && !strlen(input)) || activate)
-    return TRUE;
+  invalidate_script_source(sl);
+  compile_script_patterns(sl);
+}
 
-  argument->data = input;
+void
+cb_cookie_changed(SoupCookieJar* UNUSED(jar), SoupCookie* old_cookie, SoupCookie* new_cookie, gpointer UNUSED(data))
+{
+  SoupCookie* cookie = new_cookie ? new_cookie : old_cookie;
 
-  g_free(search_item);
-  search_item = g_strdup(input);
-  search_item_changed = TRUE;
+  /* cookies read from the store and session cookies need no writing */
+  if(Jumanji.Cookies.loading || (!(old_cookie && old_cookie->expires) && !(new_cookie && new_cookie->expires)))
+    return;
 
-  gboolean source_removed = FALSE;
-  if(search_and_highlight_id)
+  char* base = cookies_base_domain(cookie->domain);
+  if(!base || !*base)
   {
-    source_removed = g_source_remove(search_and_highlight_id);
-    search_and_highlight_id = 0;
+    g_free(base);
+    return;
   }
 
-  /* if function was launched by cb_inputbar_activate */
-  if(activate)
-  {
-    if(source_removed)
-      search_and_highlight(argument);
-  }
-  else
-    search_and_highlight_id = g_timeout_add(search_delay, (GSourceFunc)sc_search, argument);
+  g_hash_table_insert(Jumanji.Cookies.dirty, base, NULL);
 
-  return TRUE;
+  /* changes are written together in the background */
+  if(!Jumanji.Cookies.flush_id)
+    Jumanji.Cookies.flush_id = g_timeout_add_seconds(MAX(cookie_flush_interval, 1), cb_cookies_flush, NULL);
 }
 
 gboolean
-search_and_highlight(Argument* argument)
+cb_cookies_flush(gpointer UNUSED(data))
 {
-  static WebKitWebView* last_wv = NULL;
-
-  if(search_item && !strlen(search_item))
-    return FALSE;
-
-  WebKitWebView* current_wv = GET_CURRENT_TAB();
+  /* one batch at a time, the next waits for the running one */
+  if(Jumanji.Cookies.thread)
+    return TRUE;
 
-  if(search_item_changed || last_wv != current_wv)
-  {
-    webkit_web_view_unmark_text_matches(current_wv);
-    webkit_web_view_mark_text_matches(current_wv, search_item, FALSE, 0);
-    webkit_web_view_set_highlight_text_matches(current_wv, TRUE);
+  Jumanji.Cookies.flush_id = 0;
 
-    last_wv = current_wv;
-  }
+  GHashTable* batch = cookies_collect();
+  Jumanji.Cookies.thread = g_thread_try_new("cookies", cookies_thread, batch, NULL);
 
-  gboolean direction = (argument->n == BACKWARD) ? FALSE : TRUE;
-  webkit_web_view_search_text(current_wv, search_item, FALSE, direction, TRUE);
+  if(!Jumanji.Cookies.thread)
+    cookies_write(batch);
 
-  search_item_changed = FALSE;
   return FALSE;
 }
 
-/* callback implementation */
-UniqueResponse
-cb_app_message_received(UniqueApp* UNUSED(application), gint UNUSED(command), UniqueMessageData* message_data, guint UNUSED(time), gpointer UNUSED(data))
+gboolean
+cb_cookies_flushed(gpointer UNUSED(data))
 {
-  if(message_data)
-    create_tab(unique_message_data_get_text(message_data), FALSE);
+  if(Jumanji.Cookies.thread)
+    g_thread_join(Jumanji.Cookies.thread);
 
-  return UNIQUE_RESPONSE_OK;
+  Jumanji.Cookies.thread = NULL;
+
+  return FALSE;
 }
 
-gboolean
-cb_blank()
+void
+cb_soup_got_headers(SoupMessage* message, gpointer UNUSED(data))
 {
-  return TRUE;
+  if(message->status_code == SOUP_STATUS_NOT_MODIFIED)
+    Jumanji.Soup.revalidated++;
 }
 
-gboolean
-cb_destroy(GtkWidget* UNUSED(widget), gpointer UNUSED(data))
+void
+cb_soup_network_event(SoupMessage* message, GSocketClientEvent event, GIOStream* UNUSED(connection), gpointer UNUSED(data))
 {
-  pango_font_description_free(Jumanji.Style.font);
-
-  /* write bookmarks and history */
-  cmd_write(0, NULL);
-
-  /* clear bookmarks */
-  GList* list;
-  for(list = Jumanji.Global.bookmarks; list; list = g_list_next(list))
-    free(list->data);
-
-  g_list_free(Jumanji.Global.bookmarks);
+  RequestTiming* timing = g_object_get_data(G_OBJECT(message), TIMING_DATA);
+  gint64 now = g_get_monotonic_time();
 
-  /* clear history */
-  for(list = Jumanji.Global.history; list; list = g_list_next(list))
-    free(list->data);
-
-  g_list_free(Jumanji.Global.history);
-  g_list_free(Jumanji.Global.last_closed);
-
-  /* clean shortcut list */
-  ShortcutList* sc = Jumanji.Bindings.sclist;
+  if(!timing)
+    return;
 
-  while(sc)
+  switch(event)
   {
-    ShortcutList* ne = sc->next;
-    free(sc);
-    sc = ne;
+    case G_SOCKET_CLIENT_RESOLVING:
+      timing->resolving = now;
+      break;
+    case G_SOCKET_CLIENT_RESOLVED:
+      timing->resolved = now;
+      break;
+    case G_SOCKET_CLIENT_CONNECTING:
+      timing->connecting = now;
+      break;
+    case G_SOCKET_CLIENT_TLS_HANDSHAKING:
+      timing->handshaking = now;
+      break;
+    case G_SOCKET_CLIENT_COMPLETE:
+      timing->connected = now;
+      break;
+    default:
+      break;
   }
+}
 
-  /* clean loaded scripts */
-  SearchEngineList* se = Jumanji.Global.search_engines;
-
-  while(se)
-  {
-    SearchEngineList* ne = se->next;
-    free(se);
-    se = ne;
-  }
+void
+cb_soup_request_queued(SoupSession* UNUSED(session), SoupMessage* message, gpointer UNUSED(data))
+{
+  RequestTiming* timing = g_object_get_data(G_OBJECT(message), TIMING_DATA);
+  if(timing)
+    timing->queued = g_get_monotonic_time();
 
-  /* clean loaded scripts */
-  ScriptList* sl = Jumanji.Global.scripts;
+  /* the cookies of the domain have to be in the jar before it sends them */
+  cookies_load(soup_message_get_uri(message)->host);
+}
 
-  while(sl)
+void
+cb_soup_request_started(SoupSession* session, SoupMessage* message, SoupSocket* UNUSED(socket), gpointer UNUSED(data))
+{
+  /* cache hits are answered without a connection, offline everything that
+   * would need one fails before it is sent */
+  if(is_offline_request(message))
   {
-    ScriptList* ne = sl->next;
-    if(sl->content)
-      free(sl->content);
-    free(sl);
-    sl = ne;
+    soup_session_cancel_message(session, message, SOUP_STATUS_CANT_CONNECT);
+    return;
   }
 
-  /* clean markers */
-  for(list = Jumanji.Global.markers; list; list = g_list_next(list))
-    free(list->data);
-
-  g_list_free(Jumanji.Global.markers);
+  RequestTiming* timing = g_object_get_data(G_OBJECT(message), TIMING_DATA);
+  if(timing)
+    timing->sent = g_get_monotonic_time();
 
-  /* clean command history */
-  for(list = Jumanji.Global.command_history; list; list = g_list_next(list))
-    free(list->data);
+  /* requests answered by the cache never get here, redirected, retried or
+   * authenticated ones get here again but are only counted once */
+  if(message->method != SOUP_METHOD_GET || g_object_get_data(G_OBJECT(message), REVALIDATION_DATA) ||
+      g_object_get_data(G_OBJECT(message), PREFETCH_DATA))
+    return;
 
-  g_list_free(Jumanji.Global.command_history);
+  Jumanji.Soup.network++;
+  g_object_set_data(G_OBJECT(message), REVALIDATION_DATA, GINT_TO_POINTER(TRUE));
+  g_signal_connect(G_OBJECT(message), "got-headers", G_CALLBACK(cb_soup_got_headers), NULL);
+}
 
-  gtk_main_quit();
+void
+cb_soup_timing(SoupMessage* message, gpointer data)
+{
+  /* the signal data is the offset of the field to stamp */
+  RequestTiming* timing = g_object_get_data(G_OBJECT(message), TIMING_DATA);
+  if(timing)
+    G_STRUCT_MEMBER(gint64, timing, GPOINTER_TO_INT(data)) = g_get_monotonic_time();
+}
 
-  return TRUE;
+void
+cb_soup_got_chunk(SoupMessage* message, SoupBuffer* chunk, gpointer UNUSED(data))
+{
+  /* webkit streams the body, the message does not keep it */
+  RequestTiming* timing = g_object_get_data(G_OBJECT(message), TIMING_DATA);
+  if(timing)
+    timing->size += chunk->length;
 }
 
-gboolean
-cb_inputbar_kb_pressed(GtkWidget* UNUSED(widget), GdkEventKey* event, gpointer UNUSED(data))
+void
+cb_soup_timing_finished(SoupMessage* message, gpointer UNUSED(data))
 {
-  guint keyval;
-  GdkModifierType consumed_modifiers;
+  RequestTiming* timing = g_object_get_data(G_OBJECT(message), TIMING_DATA);
 
-  gdk_keymap_translate_keyboard_state(
-      Jumanji.Global.keymap, event->hardware_keycode, event->state, event->group, /* inner */
-      &keyval, NULL, NULL, &consumed_modifiers); /* outer */
+  if(!timing)
+    return;
 
-  /* inputbar shortcuts */
-  for(unsigned int i = 0; i < LENGTH(inputbar_shortcuts); i++)
-  {
-    if (keyval == inputbar_shortcuts[i].key                                               /* test key  */
-        && (event->state & ~consumed_modifiers & ALL_MASK) == inputbar_shortcuts[i].mask) /* test mask */
-    {
-      inputbar_shortcuts[i].function(&(inputbar_shortcuts[i].argument));
-      return TRUE;
-    }
-  }
+  timing->finished     = g_get_monotonic_time();
+  timing->status       = message->status_code;
+  timing->status_text  = g_strdup(message->reason_phrase);
+  timing->http_version = soup_message_get_http_version(message);
+  timing->mime_type    = g_strdup(soup_message_headers_get_content_type(message->response_headers, NULL));
 
-  return FALSE;
-}
+  /* bodies that were not read through the message only have their length */
+  if(!timing->size)
+    timing->size = soup_message_headers_get_content_length(message->response_headers);
 
-void
-cb_inputbar_changed(GtkEditable* UNUSED(editable), gpointer UNUSED(data))
-{
-  /* special commands */
-  gchar *input  = gtk_editable_get_chars(GTK_EDITABLE(Jumanji.UI.inputbar), 0, -1);
-  char identifier = input[0];
-  for(unsigned int i = 0; i < LENGTH(special_commands); i++)
-  {
-    if((identifier == special_commands[i].identifier) &&
-       (special_commands[i].always == 1))
-    {
-      special_commands[i].function(input + 1, &(special_commands[i].argument), FALSE);
-      g_free(input);
-      return;
-    }
-  }
+  if(timing->message)
+    g_object_remove_weak_pointer(G_OBJECT(message), (gpointer*) &timing->message);
+  timing->message = NULL;
 
-  g_free(input);
-  return;
+  g_object_set_data(G_OBJECT(message), TIMING_DATA, NULL);
 }
 
 gboolean
-cb_inputbar_activate(GtkEntry* entry, gpointer UNUSED(data))
+cb_prerender_free(gpointer data)
 {
-  gchar  *input  = gtk_editable_get_chars(GTK_EDITABLE(entry), 0, -1);
-  char identifier = input[0];
-  gboolean  retv = FALSE;
-  gboolean  succ = FALSE;
+  Tab* prerender = (Tab*) data;
 
-  /* no input */
-  if(strlen(input) <= 1)
-  {
-    isc_abort(NULL);
-    g_free(input);
-    return FALSE;
-  }
+  gtk_widget_destroy(gtk_widget_get_toplevel(prerender->widget));
 
-  /* special commands */
-  for(unsigned int i = 0; i < LENGTH(special_commands); i++)
-  {
-    if(identifier == special_commands[i].identifier)
-    {
-      retv = special_commands[i].function(input + 1, &(special_commands[i].argument), TRUE);
-      if(retv) isc_abort(NULL);
-      gtk_widget_grab_focus(GTK_WIDGET(GET_CURRENT_TAB_WIDGET()));
-      g_free(input);
-      return TRUE;
-    }
-  }
+  if(prerender->scripts)
+    g_ptr_array_free(prerender->scripts, TRUE);
 
-  gchar **tokens = g_strsplit(input + 1, " ", -1);
-  g_free(input);
-  gchar *command = tokens[0];
-  int     length = g_strv_length(tokens);
+  if(prerender->requests)
+    g_ptr_array_free(prerender->requests, TRUE);
 
-  /* append input to the command history */
-  if(!private_browsing)
-    Jumanji.Global.command_history = g_list_append(Jumanji.Global.command_history, g_strdup(gtk_entry_get_text(entry)));
+  g_free(prerender->stylesheet);
+  g_free(prerender->user_stylesheet);
+  g_free(prerender);
 
-  /* search commands */
-  for(unsigned int i = 0; i < LENGTH(commands); i++)
-  {
-    if((g_strcmp0(command, commands[i].command) == 0) ||
-       (g_strcmp0(command, commands[i].abbr)    == 0))
-    {
-      retv = commands[i].function(length - 1, tokens + 1);
-      succ = TRUE;
-      break;
-    }
-  }
+  return FALSE;
+}
 
-  if(retv)
-    isc_abort(NULL);
+gboolean
+cb_speculate_hover(gpointer UNUSED(data))
+{
+  Jumanji.Speculation.hover_id = 0;
+  speculate(Jumanji.Speculation.hovered);
 
-  if(!succ)
-    notify(ERROR, "Unknown command.");
+  return FALSE;
+}
 
-  Argument arg = { HIDE, NULL };
-  isc_completion(&arg);
+void
+cb_speculate_prefetched(SoupSession* UNUSED(session), SoupMessage* UNUSED(message), gpointer UNUSED(data))
+{
+  Jumanji.Speculation.pending--;
+}
 
-  gtk_widget_grab_focus(GTK_WIDGET(GET_CURRENT_TAB_WIDGET()));
-  g_strfreev(tokens);
+gboolean
+cb_status_throttle(gpointer UNUSED(data))
+{
+  /* draw the last state that has been collected during the interval */
+  if(!Jumanji.Statusbar.throttled)
+  {
+    Jumanji.Statusbar.throttle_id = 0;
+    return FALSE;
+  }
+
+  mark_dirty(Jumanji.Statusbar.throttled);
+  Jumanji.Statusbar.throttled = 0;
 
   return TRUE;
 }
@@ -4038,6 +7604,12 @@ cb_tab_kb_pressed(GtkWidget* UNUSED(widget), GdkEventKey* event, gpointer UNUSED
       Jumanji.Global.keymap, event->hardware_keycode, event->state, event->group, /* inner */
       &keyval, NULL, NULL, &consumed_modifiers); /* outer */
 
+  /* a buffer that only consists of digits is a count for the next shortcut,
+   * further digits are appended to it */
+  gboolean has_count = Jumanji.Global.mode == NORMAL
+    && Jumanji.Global.buffer && Jumanji.Global.buffer->len > 0
+    && strspn(Jumanji.Global.buffer->str, "0123456789") == Jumanji.Global.buffer->len;
+
   for(ShortcutList* sc = Jumanji.Bindings.sclist; sc; sc = sc->next)
   {
     if(
@@ -4046,16 +7618,29 @@ cb_tab_kb_pressed(GtkWidget* UNUSED(widget), GdkEventKey* event, gpointer UNUSED
        && Jumanji.Global.mode & sc->element.mode                              /* test mode */
        && sc->element.function /* a function have to be defined */
        /* if the buffer isn't empty we don't launch the function
-        * exept if the sc mode is set to ALL or have a non nul mask
+        * exept if the sc mode is set to ALL, have a non nul mask
+        * or the buffer is a count
         */
        && (
             !(Jumanji.Global.buffer && strlen(Jumanji.Global.buffer->str))
             || sc->element.mode == ALL
             || sc->element.mask
+            || (has_count && !g_ascii_isdigit(keyval))
           )
       )
     {
+      Jumanji.Global.count = has_count ? atoi(Jumanji.Global.buffer->str) : 0;
       sc->element.function(&(sc->element.argument));
+      Jumanji.Global.count = 0;
+
+      /* the count has been consumed by the shortcut */
+      if(has_count && Jumanji.Global.buffer && sc->element.function != sc_change_buffer)
+      {
+        g_string_free(Jumanji.Global.buffer, TRUE);
+        Jumanji.Global.buffer = NULL;
+        gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.buffer, "");
+      }
+
       return TRUE;
     }
   }
@@ -4110,7 +7695,11 @@ cb_tab_kb_pressed(GtkWidget* UNUSED(widget), GdkEventKey* event, gpointer UNUSED
 
       if(status == 0)
       {
+        /* leading digits are passed on as count */
+        Jumanji.Global.count = atoi(Jumanji.Global.buffer->str);
         bc->element.function(Jumanji.Global.buffer->str, &(bc->element.argument));
+        Jumanji.Global.count = 0;
+
         g_string_free(Jumanji.Global.buffer, TRUE);
         Jumanji.Global.buffer = NULL;
         gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.buffer, "");
@@ -4128,11 +7717,12 @@ cb_tab_kb_pressed(GtkWidget* UNUSED(widget), GdkEventKey* event, gpointer UNUSED
 gboolean
 cb_tab_clicked(GtkWidget* UNUSED(widget), GdkEventButton* event, gpointer data)
 {
-  int position = gtk_notebook_page_num(Jumanji.UI.view, (GtkWidget*) data);
+  Tab* tab = ((TabSlot*) data)->tab;
 
-  if(position == -1) {
+  if(!tab)
     return FALSE;
-  }
+
+  int position = tab->position;
 
   switch (event->button) {
     case 1:
@@ -4168,18 +7758,6 @@ cb_wv_button_release_event(GtkWidget* UNUSED(widget), GdkEvent* event, gpointer
   return FALSE;
 }
 
-gboolean
-cb_wv_console(WebKitWebView* UNUSED(wv), char* message, int UNUSED(line),
-    char* UNUSED(source), gpointer UNUSED(data))
-{
-  if(!strcmp(message, "hintmode_off") || !strcmp(message, "insertmode_off"))
-    change_mode(NORMAL);
-  else if(!strcmp(message, "insertmode_on"))
-    change_mode(INSERT);
-
-  return TRUE;
-}
-
 GtkWidget*
 cb_wv_create_web_view(WebKitWebView* wv, WebKitWebFrame* UNUSED(frame), gpointer UNUSED(data))
 {
@@ -4230,24 +7808,43 @@ cb_wv_mimetype_policy_decision(WebKitWebView* wv, WebKitWebFrame* UNUSED(frame),
 {
   if(!webkit_web_view_can_show_mime_type(wv, mimetype))
   {
-    webkit_web_policy_decision_download(decision);
+    /* prerenders never start downloads */
+    Tab* tab = g_object_get_data(G_OBJECT(gtk_widget_get_parent(GTK_WIDGET(wv))), "tab");
+
+    if(tab && tab->owner)
+      webkit_web_policy_decision_ignore(decision);
+    else
+      webkit_web_policy_decision_download(decision);
+
     return TRUE;
   }
 
   return FALSE;
 }
 
+gboolean
+cb_wv_kb_pressed(GtkWidget* UNUSED(widget), GdkEventKey* event, gpointer UNUSED(data))
+{
+  /* runs before the webview handles the key, so keys typed into the page
+   * are recorded as well */
+  record_key(event);
+
+  return FALSE;
+}
+
 gboolean
 cb_wv_hover_link(WebKitWebView* UNUSED(wv), char* UNUSED(title), char* link, gpointer UNUSED(data))
 {
-  if(link)
-  {
-    link = g_strconcat("Link: ", link, NULL);
-    gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.text, link);
-    g_free(link);
-  }
-  else
-    gtk_label_set_text((GtkLabel*) Jumanji.Statusbar.text, webkit_web_view_get_uri(GET_CURRENT_TAB()));
+  set_link(link);
+
+  /* warm up the link once the pointer rests on it */
+  if(Jumanji.Speculation.hover_id)
+    g_source_remove(Jumanji.Speculation.hover_id);
+
+  g_free(Jumanji.Speculation.hovered);
+  Jumanji.Speculation.hovered  = (link && preconnect) ? g_strdup(link) : NULL;
+  Jumanji.Speculation.hover_id = Jumanji.Speculation.hovered ?
+    g_timeout_add(MAX(preconnect_delay, 1), cb_speculate_hover, NULL) : 0;
 
   return TRUE;
 }
@@ -4279,11 +7876,23 @@ cb_wv_inspector_view(WebKitWebInspector* UNUSED(inspector), WebKitWebView* wv, g
 }
 
 gboolean
-cb_wv_nav_policy_decision(WebKitWebView* UNUSED(wv), WebKitWebFrame* UNUSED(frame),
+cb_wv_nav_policy_decision(WebKitWebView* wv, WebKitWebFrame* frame,
     WebKitNetworkRequest* request, WebKitWebNavigationAction* action,
     WebKitWebPolicyDecision* decision, gpointer UNUSED(data))
 {
-  switch(webkit_web_navigation_action_get_button(action))
+  int  button = webkit_web_navigation_action_get_button(action);
+  Tab* tab    = g_object_get_data(G_OBJECT(gtk_widget_get_parent(GTK_WIDGET(wv))), "tab");
+
+  /* show the prerendered page instead of loading it again */
+  if(button != 2 && tab && tab->prerender && frame == webkit_web_view_get_main_frame(wv)
+      && !strcmp(tab->prerender_uri, webkit_network_request_get_uri(request)))
+  {
+    webkit_web_policy_decision_ignore(decision);
+    prerender_swap(tab);
+    return TRUE;
+  }
+
+  switch(button)
   {
     case 1: /* left mouse button */
       return FALSE;
@@ -4298,23 +7907,106 @@ cb_wv_nav_policy_decision(WebKitWebView* UNUSED(wv), WebKitWebFrame* UNUSED(fram
   }
 }
 
+void
+cb_wv_resource_request(WebKitWebView* wv, WebKitWebFrame* frame, WebKitWebResource* UNUSED(resource),
+    WebKitNetworkRequest* request, WebKitNetworkResponse* response, gpointer data)
+{
+  Tab* tab = (Tab*) data;
+  const char* uri = webkit_network_request_get_uri(request);
+
+  if(!Jumanji.Blocker.filter || !blocker_match(Jumanji.Blocker.filter, uri))
+  {
+    if(uri && !strncmp(uri, "http", 4))
+    {
+      Jumanji.Soup.requests++;
+      record_request(tab, wv, frame, request, response);
+
+      /* responses from the cache skip the session, but the page may read its cookies */
+      SoupMessage* message = webkit_network_request_get_message(request);
+      if(message)
+        cookies_load(soup_message_get_uri(message)->host);
+
+      /* offline, stale entries are good enough and misses never reach the network */
+      if(message && (offline || (tab && tab->offline)))
+      {
+        soup_message_headers_replace(message->request_headers, "Cache-Control", "max-stale");
+        soup_message_headers_replace(message->request_headers, OFFLINE_HEADER, "1");
+      }
+    }
+    return;
+  }
+
+  /* a blocked request loads nothing instead */
+  webkit_network_request_set_uri(request, "about:blank");
+
+  Jumanji.Blocker.blocked++;
+  if(tab)
+    tab->blocked++;
+}
+
 gboolean
-cb_wv_notify_progress(WebKitWebView* wv, GParamSpec* UNUSED(pspec), gpointer UNUSED(data))
+cb_wv_notify_load_status(WebKitWebView* wv, GParamSpec* UNUSED(pspec), gpointer data)
 {
-  if(wv == GET_CURRENT_TAB() && gtk_notebook_get_current_page(Jumanji.UI.view) != -1)
-    update_uri();
+  Tab* tab = (Tab*) data;
+
+  if(tab->owner)
+    return TRUE;
+
+  switch(webkit_web_view_get_load_status(wv))
+  {
+    case WEBKIT_LOAD_COMMITTED:
+      /* the page went somewhere else than its prerender */
+      prerender_drop(tab);
+
+      /* the hovered link is gone with the old page */
+      if(tab == Jumanji.Tabs.current)
+        set_link(NULL);
+      break;
+    case WEBKIT_LOAD_FINISHED:
+      prerender_start(tab);
+      break;
+    default:
+      break;
+  }
+
+  return TRUE;
+}
+
+gboolean
+cb_wv_notify_progress(WebKitWebView* wv, GParamSpec* UNUSED(pspec), gpointer data)
+{
+  int flags = 0;
+
+  /* prerenders have no label */
+  if(((Tab*) data)->owner)
+    return TRUE;
+
+  if(data == Jumanji.Tabs.current)
+    flags |= DIRTY_URI;
+
+  /* the label of untitled tabs shows the loading state */
+  if(!webkit_web_view_get_title(wv))
+  {
+    queue_tab_label((Tab*) data);
+    flags |= DIRTY_LABELS;
+  }
+
+  if(flags)
+    mark_dirty_throttled(flags);
 
   return TRUE;
 }
 
 gboolean
-cb_wv_notify_title(WebKitWebView* wv, GParamSpec* UNUSED(pspec), gpointer UNUSED(data))
+cb_wv_notify_title(WebKitWebView* wv, GParamSpec* UNUSED(pspec), gpointer data)
 {
   const char* title = webkit_web_view_get_title(wv);
-  if(title)
+  if(title && !((Tab*) data)->owner)
   {
-    gtk_window_set_title(GTK_WINDOW(Jumanji.UI.window), title);
-    update_status();
+    if(data == Jumanji.Tabs.current)
+      mark_dirty(DIRTY_TITLE);
+
+    mark_tab_dirty((Tab*) data);
   }
 
   return TRUE;
@@ -4323,7 +8015,18 @@ cb_wv_notify_title(WebKitWebView* wv, GParamSpec* UNUSED(pspec), gpointer UNUSED
 gboolean
 cb_wv_scrolled(GtkAdjustment* UNUSED(adjustment), gpointer UNUSED(data))
 {
-  update_position();
+  mark_dirty(DIRTY_POSITION);
+
+  /* hints only cover the visible part of the page, they are collected again
+   * once scrolling has settled */
+  if(Jumanji.Hints.engine && Jumanji.Global.mode == FOLLOW)
+  {
+    if(Jumanji.Hints.rescan_id)
+      g_source_remove(Jumanji.Hints.rescan_id);
+
+    Jumanji.Hints.rescan_id = g_timeout_add(MAX(hint_interval, 0), cb_hints_rescan, NULL);
+  }
+
   return TRUE;
 }
 
@@ -4342,23 +8045,59 @@ cb_wv_window_policy_decision(WebKitWebView* UNUSED(wv), WebKitWebFrame* UNUSED(f
 }
 
 gboolean
-cb_wv_window_object_cleared(WebKitWebView* UNUSED(wv), WebKitWebFrame* UNUSED(frame), gpointer context,
-    gpointer UNUSED(window_object), gpointer UNUSED(data))
+cb_wv_window_object_cleared(WebKitWebView* wv, WebKitWebFrame* frame, gpointer context,
+    gpointer UNUSED(window_object), gpointer data)
 {
-  /* load all added scripts */
+  /* the signal is emitted once per frame of the view it belongs to, so the
+   * scripts are evaluated exactly once in the frame's own context */
+  Tab* tab            = (Tab*) data;
+  gboolean main_frame = (frame == webkit_web_view_get_main_frame(wv));
+
+  if(tab && main_frame)
+  {
+    tab->injections = 0;
+    tab->frames     = 0;
 
-  JSStringRef script;
-  JSValueRef exc;
-  GString *buffer = g_string_new(NULL);
+    /* the hinted elements are gone with the old page */
+    if(Jumanji.Hints.tab == tab)
+    {
+      hints_reset();
+
+      if(Jumanji.Global.mode == FOLLOW)
+        change_mode(NORMAL);
+    }
+  }
+
+  if(tab)
+    tab->frames++;
+
+  /* frames may belong to other sites, only the page itself gets the bridge */
+  if(tab && main_frame)
+    install_bridge((JSContextRef) context, tab);
+
+  if(tab && main_frame)
+  {
+    tab->blocked = 0;
+    apply_hiding_stylesheet(tab, webkit_web_frame_get_uri(frame));
+  }
+
+  /* the patterns are matched once per page, its frames share the result */
+  if(tab && (main_frame || tab->script_generation != Jumanji.Global.script_generation))
+    match_scripts(tab, webkit_web_frame_get_uri(webkit_web_view_get_main_frame(wv)));
+
+  /* every script is evaluated on its own, so that its time and exceptions
+   * are attributed to it and a failing script does not stop the others */
+  for(unsigned int i = 0; tab && i < tab->scripts->len; i++)
+  {
+    ScriptList* sl = (ScriptList*) g_ptr_array_index(tab->scripts, i);
 
-  for (ScriptList *l = Jumanji.Global.scripts; l; l=l->next) {
-    g_string_append(buffer, l->content);
+    if(!main_frame && !sl->all_frames)
+      continue;
+
+    evaluate_script((JSContextRef) context, get_script_source(sl), sl->path, "injection", NULL);
+    tab->injections++;
   }
-  script = JSStringCreateWithUTF8CString(buffer->str);
-  JSEvaluateScript((JSContextRef)context, script, JSContextGetGlobalObject((JSContextRef)context), NULL, 0, &exc);
-  JSStringRelease(script);
-  g_string_free(buffer, true);
-  load_all_scripts();
+
   return TRUE;
 }
 
@@ -4375,6 +8114,10 @@ int main(int argc, char* argv[])
   Jumanji.UI.winid = 0;
   Jumanji.Global.arguments = argv;
 
+  char* record_file = NULL;
+  char* replay_file = NULL;
+  char* standin_dir = NULL;
+
   int i;
   for(i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++)
   {
@@ -4387,6 +8130,18 @@ int main(int argc, char* argv[])
           Jumanji.UI.winid = argv[i];
         }
         break;
+      case 'r':
+        if(++i < argc)
+          record_file = argv[i];
+        break;
+      case 'p':
+        if(++i < argc)
+          replay_file = argv[i];
+        break;
+      case 'd':
+        if(++i < argc)
+          standin_dir = argv[i];
+        break;
     }
   }
 
@@ -4429,8 +8184,29 @@ int main(int argc, char* argv[])
   if(auto_save_interval)
     g_timeout_add_seconds(auto_save_interval, auto_save, NULL);
 
-  /* create tab */
-  if(argc < 2)
+  /* init garbage collection of background tabs */
+  if(gc_interval > 0)
+    g_timeout_add_seconds(gc_interval, cb_gc_pass, NULL);
+
+  /* record and replay */
+  if(standin_dir && !standin_start(standin_dir))
+    return 1;
+
+  if(record_file)
+  {
+    Jumanji.Replay.record = fopen(record_file, "w");
+
+    if(!Jumanji.Replay.record)
+    {
+      fprintf(stderr, "jumanji: could not open record file '%s'\n", record_file);
+      return 1;
+    }
+
+    Jumanji.Replay.timer = g_timer_new();
+  }
+
+  /* create tab, the options have been consumed by now */
+  if(i >= argc)
   {
     gboolean session_restored = FALSE;
 
@@ -4456,6 +8232,9 @@ int main(int argc, char* argv[])
   if(!show_tabbar)
     gtk_widget_hide(GTK_WIDGET(Jumanji.UI.tabbar));
 
+  if(replay_file && !replay_start(replay_file))
+    return 1;
+
   gtk_main();
 
   return 0;